@@ -5,9 +5,12 @@
 #include "sfw/Gfx/Render.hpp"
 #include "sfw/Layouts/VBox.hpp"
 #include "sfw/Gfx/Elements/Wallpaper.hpp"
+#include "sfw/TimerWheel.hpp"
+#include "sfw/util/mpsc_queue.hpp"
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/Cursor.hpp>
 #include <SFML/System/Clock.hpp>
@@ -15,6 +18,12 @@
 #include <string_view>
 #include <string>
 #include <unordered_map>
+#include <functional> // function, hash, equal_to
+#include <vector>
+#include <span>
+#include <atomic>
+#include <chrono>
+#include <optional>
 #include <system_error>
 
 namespace sfw
@@ -30,6 +39,7 @@ class GUI: public VBox
 public:
 	GUI(sf::RenderWindow& window, const sfw::Theme::Cfg& themeCfg = Theme::DEFAULT,
 		bool own_the_window = true);
+	~GUI() override;
 
 	/**
 	 * Return true if no errors & has not been closed.
@@ -52,10 +62,77 @@ public:
 	 */
 	bool process(const sf::Event& event);
 
+	/**
+	 * Process a batch of events (e.g. everything queued since the last frame)
+	 * Consecutive mouse moves are collapsed into the last one, and consecutive
+	 * wheel scrolls (of the same wheel) are merged into one, with the summed
+	 * delta, so bursts from high-rate mice don't cost a full dispatch (and
+	 * hover state change etc.) for every stale position. Everything else is
+	 * processed one by one, in the original order. Stops at a CLOSE event.
+	 * Returns false (like process() above) if the GUI is (or has become) inactive.
+	 */
+	bool process(std::span<const sf::Event> events);
+
 	/**
 	 * Draw the entire GUI to the backend (i.e. SFML)
+	 * Returns false (and draws nothing) if the GUI is not active.
+	 */
+	bool render();
+
+	/**
+	 * Check if anything has changed since the last render(), or a time-based
+	 * visual (like a tooltip fading out, or the blinking text cursor) needs
+	 * the next frame. If not, the app can skip calling render() (and display()),
+	 * as the next frame would be identical to the current one:
+	 *
+	 *     if (gui.needsRedraw()) { gui.render(); window.display(); }
+	 *
+	 * Note: this will also "tick" the time-based stuff for the frame, so
+	 * it should be called once per frame, before render(). (If it returns
+	 * false, the next call will tick again, as no frame was consumed.)
+	 */
+	bool needsRedraw();
+
+	/**
+	 * Time left (in seconds) until the next time-based visual change (like
+	 * the text cursor blinking, or a tooltip appearing), or 0 if there's
+	 * something to redraw already. (Widgets animating on every tick get one
+	 * per FRAME_INTERVAL.)
+	 * Returns nullopt if nothing is scheduled, i.e. the GUI could only change
+	 * due to input (or changes made by the app itself).
 	 */
-	void render();
+	std::optional<float> nextDeadline();
+
+	/**
+	 * Sleep until either events arrive, or the next deadline (see above) is due
+	 * (ticking the GUI for it then, see needsRedraw()), then process all the
+	 * pending events as a batch (see process() above),
+	 * also passing each of them (as-is) to `handler`, if set, for a low-CPU
+	 * event loop that still keeps the visuals going:
+	 *
+	 *     while (gui.waitAndProcess(window)) { gui.render(); window.display(); }
+	 *
+	 * Note: since SFML can't wait for events with a timeout, pending deadlines
+	 * are waited for by polling in short naps (see INPUT_POLL_INTERVAL); it
+	 * only truly blocks (in waitEvent()) when there are none, and there has
+	 * been no post() from other threads for POST_IDLE_TIMEOUT (as they can't
+	 * interrupt waitEvent(): a command posted after that may have to wait for
+	 * the next input event, or deadline).
+	 *
+	 * Returns false (like process()) if the GUI is (or has just become) inactive.
+	 */
+	bool waitAndProcess(sf::Window& window, const std::function<void(const sf::Event&)>& handler = {});
+	bool waitAndProcess(const std::function<void(const sf::Event&)>& handler = {}) { return waitAndProcess(m_window, handler); }
+	static constexpr float INPUT_POLL_INTERVAL = 0.01f; // s
+	static constexpr float FRAME_INTERVAL = 1.f / 60; // s, for per-tick animations
+	static constexpr float POST_IDLE_TIMEOUT = 1.f; // s, see above
+
+	/**
+	 * Run the pending layout pass now (see WidgetContainer::updateLayout())
+	 * render() and process() do this automatically, so it's only needed for
+	 * querying the geometry of widgets right after adding/changing them.
+	 */
+	using WidgetContainer::updateLayout;
 
 	/**
 	 * Shut down the GUI, and close the window, too, if owning it
@@ -68,22 +145,34 @@ public:
 	/*************************************************************************
 	 Name->widget registry
 
-	 If name == "", the widget will be registered with a default name, which
-	 is also a unique internal ID (for disagnostic purposes).
+	 If name == "", nothing is registered: every widget can always be found
+	 by its default name, too, which is a unique internal ID (for disagnostic
+	 purposes).
+
+	 A widget can have multiple names (aliases); recall(widget) returns the
+	 one given last.
 
 	 If `override_existing` is true, a previously registered widget with the
-	 same name will lose its name, and will revert to having a default instead.
+	 same name will lose that name (but not its other ones, if any).
 
 	 Notes:
 	 - Since default names uniquely identify widgets, the override flag is
 	   redudndant with empty names.
+	 - Default names are not stored: they are just generated when queried
+	   (so unnamed widgets cost nothing), and looking a widget up by its
+	   default name needs a (slow) search of the widget tree.
+	 - Lookups by name don't allocate. Looking up the name of a widget is
+	   also fast (there's a reverse index).
+	 - Every change here bumps internal::name_registry_generation, to let
+	   cached lookup results (see "name"_W) know that they may be stale.
+	   So does adding or detaching any widget, named or not (as widgets can
+	   be looked up by their default names, too).
 	 - The registry doesn't store const pointers, to allow any widget operations
 	   to be applied directly on a retrieved pointer.
-	 - If you're wondering why remember() doesn't have a const string& input
-	   type, see its implementation.
 	 *************************************************************************/
-	bool remember(Widget* widget, std::string name, bool override_existing = true);
+	bool remember(Widget* widget, const std::string& name, bool override_existing = true);
 	Widget* recall(std::string_view name) const;
+	Widget* recall(const internal::HashedName& name) const; // With a precomputed hash (see internal::name_hash())
 	std::string recall(const Widget*) const;
 
 	/**
@@ -127,6 +216,60 @@ public:
 	// Accumulated session time (minus while !active()), in seconds
 	float sessionTime() const;
 
+	/*************************************************************************
+	 Timers
+
+	 One-shot (period == 0) or periodic callbacks, fired by the per-frame tick
+	 (see needsRedraw() and render()), so they run on the GUI thread, at frame
+	 granularity. (The timer resolution itself is 1 ms.) Only the timers that
+	 are actually due cost anything per frame, however many are pending.
+
+	 If an `owner` widget is set, the timer is stopped automatically when that
+	 widget is deleted, or removed from the GUI (so the callback can safely
+	 capture it).
+
+	 Deadlines are either relative to now (`delay`), or in session time (see
+	 sessionTime()). Missed periods (e.g. while the app was busy) are skipped,
+	 not fired in a burst.
+
+	 Stopping an already stopped (or fired) timer is a harmless no-op, as is
+	 stopping a null TimerId.
+	 *************************************************************************/
+	using TimerId = TimerWheel::Id;
+	TimerId startTimer(float delay, std::function<void()> callback, float period = 0, const Widget* owner = nullptr);
+	TimerId startTimerAt(float sessiontime, std::function<void()> callback, float period = 0, const Widget* owner = nullptr);
+	bool stopTimer(TimerId id); // false if it's not pending (anymore)
+	bool timerPending(TimerId id) const;
+
+	/*************************************************************************
+	 Cross-thread commands
+
+	 The GUI (and the widgets) must only be used from the thread running it
+	 (the one calling process() and render()). Other threads can post() work
+	 to it instead, which will then be run on the GUI thread, in posting order
+	 (per posting thread), by the next process(), render() or needsRedraw().
+
+	 Posting is lock-free (see util::MPSCQueue), and so is the draining of
+	 the queue on the GUI thread.
+
+	 Widget commands target a widget by handle, and are just dropped if it's
+	 gone by the time they would run. (Note: the handle itself must have been
+	 obtained on the GUI thread, e.g. before starting the worker.)
+
+	 Commands still queued when the GUI is destroyed are discarded, and
+	 nothing must be posted after that (i.e. join the workers before).
+	 *************************************************************************/
+	void post(std::function<void()> command);
+
+	template <std::derived_from<Widget> W, std::invocable<W*> F>
+	void post(WidgetHandle<W> target, F&& command)
+	{
+		post([target, command = std::forward<F>(command)]() mutable {
+			if (auto* w = target.get(); w) command(w);
+		});
+	}
+
+
 private:
 	/**
 	 * "Soft-reset" the GUI state, keeping the current config & widgets
@@ -154,6 +297,18 @@ private:
 
 // ---- Helpers --------------------------------------------------------------
 
+	// Current session time, in timer ticks (ms)
+	TimerWheel::Tick timer_now() const;
+	TimerId start_timer(TimerWheel::Tick due, std::function<void()> callback, float period, const Widget* owner);
+
+	// Run the commands posted so far (see post())
+	void run_posted();
+
+	// The actual event handling of process(event)
+	bool dispatch_event(const sf::Event& event);
+	// Delete the widgets removed during event dispatch (see WidgetContainer::remove())
+	void delete_removed();
+
 	// Fill the window if managing (owning) it, else just the GUI rect,
 	// with the current Theme::bgColor, then show the wallpaper, if set
 	// Note: a clearing background fill is needed even when there's a
@@ -166,11 +321,47 @@ private:
 	bool m_own_window;
 	sfw::Theme::Cfg m_themeCfg;
 	sfw::Wallpaper m_wallpaper;
+	sf::Vertex m_bgRect[4]; // Background fill, if not owning the window
+	gfx::Renderer m_renderer;
 	sf::Cursor::Type m_cursorType;
 	sf::Clock m_clock;
 	sf::Time m_sessionTime;
-	std::unordered_map<std::string, Widget*> widgets;
+	bool m_ticked = false; // Ticked for the next frame already (by needsRedraw())
+	std::vector<sf::Event> m_eventBatch; // For waitAndProcess() (kept to reuse the buffer)
+	util::MPSCQueue<std::function<void()>> m_commands; // See post()
+	// Posting activity (see waitAndProcess()):
+	std::atomic<std::size_t> m_postsPending = 0; // Posted, but not yet run
+	std::atomic<std::chrono::steady_clock::rep> m_lastPostTime = 0; // (steady_clock ticks; 0: never)
+	TimerWheel m_timers;
+	// Name registry (see remember()/recall())
+	// (Transparent, for lookups by string_view, or by a precomputed hash (like
+	// of the "name"_W literals), without rehashing)
+	struct NameHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const noexcept { return internal::name_hash(name); }
+		size_t operator()(const internal::HashedName& key) const noexcept { return key.hash; }
+	};
+	struct NameEq
+	{
+		using is_transparent = void;
+		bool operator()(std::string_view a, std::string_view b) const noexcept { return a == b; }
+		bool operator()(const internal::HashedName& a, std::string_view b) const noexcept { return a.name == b; }
+		bool operator()(std::string_view a, const internal::HashedName& b) const noexcept { return a == b.name; }
+	};
+	std::unordered_map<std::string, Widget*, NameHash, NameEq> widgets;
+	std::unordered_map<const Widget*, std::vector<std::string>> m_widgetNames; // Reverse index (of the named ones only), in naming order
+	void forget(const Widget* widget); // Drop all its names (if any)
+	void forget(const Widget* widget, const std::string& name); // Drop just this one
+	unsigned m_dispatching = 0; // Nesting depth of process(event) calls
+	std::vector<Widget*> m_removedWidgets; // Detached during dispatch, to be deleted after it
+	friend class WidgetContainer; // For sizing up the registry before bulk inserts, and forgetting/deleting removed widgets
 	bool m_closed = false;
+	// Tooltip overlay: only the armed (i.e. delayed or visible) tooltips are
+	// listed here (by Tooltip::setState()), so drawing & ticking them doesn't
+	// need to scan the widget tree
+	std::vector<Tooltip*> m_activeTooltips;
+	friend class Tooltip;
 
 // ---- Misc. hackery... -----------------------------------------------------
 	// Convenience helper to find the GUI instance easily (assuming the client
@@ -17,11 +17,13 @@
 #include "sfw/Widgets/ImageButton.hpp"
 #include "sfw/Widgets/TextBox.hpp"
 #include "sfw/Widgets/DrawHost.hpp"
+#include "sfw/Widgets/ListView.hpp"
 
 // Layout containers
 #include "sfw/Layouts/VBox.hpp"
 #include "sfw/Layouts/HBox.hpp"
 #include "sfw/Layouts/Form.hpp"
+#include "sfw/Layouts/ScrollArea.hpp"
 
 // Misc
 #include "sfw/Gfx/Color.hpp" // Likely included by the others, though...
@@ -18,9 +18,12 @@ protected:
 //  Implementations should perform the actual drawing like:
 //  void draw(const RenderContext& ctx) const
 //  {
-//      ctx.target.draw(my_SFML_drawable, ctx.props);
+//      ctx.draw(my_SFML_drawable, ctx.props);
 //  }
 //
+//  (ctx.draw() goes via the (batching) renderer, if there's one in the context,
+//  or directly to ctx.target otherwise.)
+//
 //  This way widget interfaces can be designed entirely backend-independently,
 //  only the implementations would need to access it directly.
 };
@@ -1,6 +1,8 @@
 #ifndef GUI_ARROW_SFML_HPP
 #define GUI_ARROW_SFML_HPP
 
+#include "sfw/Gfx/Render.hpp"
+
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Color.hpp>
@@ -9,7 +11,7 @@
 namespace sfw
 {
 
-class Arrow: public sf::Drawable
+class Arrow: public gfx::Drawable
 {
 public:
     enum Direction
@@ -23,6 +25,8 @@ public:
     Arrow(Direction direction);
 
     void setFillColor(const sf::Color& color);
+    // Modulate the texture with this color
+    void setColor(const sf::Color& color);
 
     void move(sf::Vector2f delta);
 
@@ -31,7 +35,9 @@ public:
     sf::Vector2f getSize() const;
 
 private:
-    void draw(sf::RenderTarget& target, const sf::RenderStates& states) const;
+    void draw(const gfx::RenderContext& ctx) const override;
+    // For drawing directly with SFML:
+    void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
 
     void updateGeometry(float x, float y, Direction direction);
 
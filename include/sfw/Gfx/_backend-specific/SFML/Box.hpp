@@ -2,6 +2,7 @@
 #define _SFW_BOX_SFML_HPP_
 
 #include "sfw/ActivationState.hpp"
+#include "sfw/Gfx/Render.hpp"
 
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Vertex.hpp>
@@ -18,7 +19,7 @@ namespace sfw
 /**
  * Utility class used by widgets for holding visual components
  */
-class Box: public sf::Drawable
+class Box: public gfx::Drawable
 {
 public:
     enum Type
@@ -53,6 +54,12 @@ public:
      */
     void setFillColor(sf::Color color);
 
+    /**
+     * Modulate the texture with this color (via the vertex colors, so
+     * without any extra drawing)
+     */
+    void setColor(sf::Color color);
+
     void press();
     void release();
 
@@ -62,6 +69,7 @@ public:
     bool contains(float x, float y) const;
 
     void applyState(ActivationState state);
+    ActivationState activationState() const { return m_activationState; }
 
     template <class T>
     void centerItem(T& item)
@@ -79,6 +87,8 @@ public:
     void centerVerticalTextVertically(sf::Text& text);
 
 protected:
+    void draw(const gfx::RenderContext& ctx) const override;
+    // For drawing directly with SFML:
     void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
 
     virtual void onPress() {};
@@ -129,8 +139,14 @@ private:
     void setSegmentTextureCoords(StripSegment n, float txleft, float txtop, float txwidth, float txheight);
 
 
+    /**
+     * Sync the fill rect with the current box geometry
+     */
+    void updateFillGeometry();
+
     ActivationState m_activationState;
     sf::Vertex m_vertices[VERTEX_COUNT];
+    sf::Vertex m_fill[4]; // Only drawn if m_fillColor is set
     std::optional<sf::Color> m_fillColor;
 };
 
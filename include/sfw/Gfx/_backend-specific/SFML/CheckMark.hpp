@@ -1,6 +1,8 @@
 #ifndef GUI_CHECKMARK_SFML_HPP
 #define GUI_CHECKMARK_SFML_HPP
 
+#include "sfw/Gfx/Render.hpp"
+
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Color.hpp>
@@ -9,7 +11,7 @@
 namespace sfw
 {
 
-class CheckMark: public sf::Drawable
+class CheckMark: public gfx::Drawable
 {
 public:
     CheckMark();
@@ -22,7 +24,9 @@ public:
     void setColor(const sf::Color& color);
 
 private:
-    void draw(sf::RenderTarget& target, const sf::RenderStates& states) const;
+    void draw(const gfx::RenderContext& ctx) const override;
+    // For drawing directly with SFML:
+    void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
 
     void updateGeometry(float x, float y);
 
@@ -3,7 +3,7 @@
 
 #include "sfw/Gfx/Render.hpp"
 
-#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/Color.hpp>
 
 namespace sfw {
@@ -21,9 +21,6 @@ struct FilledRect_Impl : public gfx::Drawable
 	sf::Vector2f position{};
 	sf::Color colorFill{};
 	sf::Color colorBorder{};
-	//!!?? It's a trade-off between size (the rather fat SFML Rect. (Shape) object here)
-	//!!?? and speed (reinitializing the rect. from scratch in each frame, in draw())...
-	//!!?? sf::RectangleShape m_rect;
 
 	Self() = default;
 
@@ -39,19 +36,54 @@ struct FilledRect_Impl : public gfx::Drawable
 
 protected:
 	//----------------------------------------------------------------------------
+	void draw(const gfx::RenderContext& ctx) const override
+	{
+		update_vertices();
+
+		auto lstates = ctx.props;
+		lstates.texture = nullptr;
+		ctx.draw(m_fill, 4, sf::PrimitiveType::TriangleStrip, lstates);
+		ctx.draw(m_border, 10, sf::PrimitiveType::TriangleStrip, lstates);
+	}
+
 	void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override
 	{
-		auto lstates = states;
+		draw(gfx::RenderContext{target, states});
+	}
+
+private:
+	//----------------------------------------------------------------------------
+	// The params. are public (so they can change any time), but the vertices
+	// only need to be rebuilt if they actually did, which is checked here
+	void update_vertices() const
+	{
+		auto [x0, y0] = position;
+		auto [x1, y1] = position + size;
 
-		sf::RectangleShape r(size);
-		r.setPosition(position);
-		r.setFillColor(colorFill);
-		r.setOutlineColor(colorBorder);
-		r.setOutlineThickness(1);
+		if (!m_valid || m_fill[0].position != position || m_fill[3].position != sf::Vector2f{x1, y1})
+		{
+			m_fill[0].position = {x0, y0}; m_fill[1].position = {x0, y1};
+			m_fill[2].position = {x1, y0}; m_fill[3].position = {x1, y1};
 
-		target.draw(r, lstates);
+			// 1px border around (i.e. outside) the rect, like a RectangleShape outline
+			const sf::Vector2f border[10] = {
+				{x0 - 1, y0 - 1}, {x0, y0}, {x1 + 1, y0 - 1}, {x1, y0}, {x1 + 1, y1 + 1},
+				{x1, y1}, {x0 - 1, y1 + 1}, {x0, y1}, {x0 - 1, y0 - 1}, {x0, y0},
+			};
+			for (size_t i = 0; i < 10; ++i) m_border[i].position = border[i];
+		}
+		if (!m_valid || m_fill[0].color != colorFill)
+			for (auto& v : m_fill) v.color = colorFill;
+		if (!m_valid || m_border[0].color != colorBorder)
+			for (auto& v : m_border) v.color = colorBorder;
+
+		m_valid = true;
 	}
 
+	mutable sf::Vertex m_fill[4];
+	mutable sf::Vertex m_border[10];
+	mutable bool m_valid = false;
+
 //!!#undef Self
 }; // class
 
@@ -22,8 +22,9 @@ public:
 
     void setFillColor(sf::Color color);
     void setItemColor(sf::Color color);
-    // This would draw a filled rect *over* the "item" of ItemBox, so `color`
-    // would usually need an alpha value set accordingly to be practical:
+    // Tint the box, and its "item", too, towards `color`: the alpha of `color`
+    // sets the strength of the tint (0: none, 255: full modulation by `color`)
+    // (Done via the vertex colors, so it costs no extra drawing.)
     void setTintColor(sf::Color color);
 
     void applyState(ActivationState state);
@@ -32,13 +33,16 @@ public:
     inline const T& item() const { return m_item; }
 
 private:
+    void draw(const gfx::RenderContext& ctx) const override;
     void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
     void onPress() override;
     void onRelease() override;
 
+    void updateItemColor(ActivationState state);
+
     T m_item;
     std::optional<sf::Color> m_itemColor;
-    std::optional<sf::Color> m_tintColor;
+    std::optional<sf::Color> m_tintColor; // The modulating color derived from the tint
 };
 
 } // namespace
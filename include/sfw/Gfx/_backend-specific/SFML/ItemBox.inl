@@ -1,7 +1,9 @@
 #include "sfw/Theme.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <cstdint>
 
 namespace sfw
 {
@@ -26,7 +28,7 @@ template <class T>
 void ItemBox<T>::setItemColor(sf::Color color)
 {
     m_itemColor = color;
-    m_item.setFillColor(m_itemColor.value());
+    updateItemColor(activationState());
 }
 
 template <class T>
@@ -38,7 +40,11 @@ void ItemBox<T>::setFillColor(sf::Color color)
 template <class T>
 void ItemBox<T>::setTintColor(sf::Color color)
 {
-    m_tintColor = color;
+    // Fade the modulating color from white to `color`, according to its alpha
+    auto fade = [a = color.a](uint8_t c) { return uint8_t(255 - (255 - c) * a / 255); };
+    m_tintColor = sf::Color(fade(color.r), fade(color.g), fade(color.b));
+    Box::setColor(m_tintColor.value());
+    updateItemColor(activationState());
 }
 
 
@@ -46,48 +52,57 @@ template <class T>
 void ItemBox<T>::applyState(ActivationState state)
 {
     Box::applyState(state);
+    updateItemColor(state);
+}
+
+template <class T>
+void ItemBox<T>::updateItemColor(ActivationState state)
+{
+    sf::Color color;
     if (m_itemColor)
     {
-        m_item.setFillColor(m_itemColor.value());
+        color = m_itemColor.value();
     }
     else switch (state)
     {
     case ActivationState::Default:
-        m_item.setFillColor(m_type == Click ? Theme::click.textColor : Theme::input.textColor);
+        color = m_type == Click ? Theme::click.textColor : Theme::input.textColor;
         break;
     case ActivationState::Hovered:
-        m_item.setFillColor(m_type == Click ? Theme::click.textColorHover : Theme::input.textColorHover);
+        color = m_type == Click ? Theme::click.textColorHover : Theme::input.textColorHover;
         break;
     case ActivationState::Pressed:
     case ActivationState::Focused:
-        m_item.setFillColor(m_type == Click ? Theme::click.textColorFocus : Theme::input.textColorFocus);
+        color = m_type == Click ? Theme::click.textColorFocus : Theme::input.textColorFocus;
         break;
     case ActivationState::Disabled:
-        m_item.setFillColor(m_type == Click ? Theme::click.textColorDisabled : Theme::input.textColorDisabled);
+        color = m_type == Click ? Theme::click.textColorDisabled : Theme::input.textColorDisabled;
         break;
     }
+    // Items with a separate modulating color (like Arrow, which ignores the
+    // theme's text colors) are tinted via that, the others via their fill color
+    if constexpr (requires { m_item.setColor(color); })
+    {
+        if (m_tintColor) m_item.setColor(m_tintColor.value());
+    }
+    else
+    {
+        if (m_tintColor) color *= m_tintColor.value();
+    }
+    m_item.setFillColor(color);
+}
+
+template <class T>
+void ItemBox<T>::draw(const gfx::RenderContext& ctx) const
+{
+    Box::draw(ctx);
+    ctx.draw(m_item, ctx.props);
 }
 
 template <class T>
 void ItemBox<T>::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
 {
-    Box::draw(target, states);
-    target.draw(m_item, states);
-    // "Tint" the box *after* the item has been drawn! (So, alpha is expected to have been set accordingly!)
-    if (m_tintColor)
-    {
-/*
-        sf::RectangleShape r(sf::Vector2f(getSize().x - 2 * (float)Theme::borderSize,
-                                          getSize().y - 2 * (float)Theme::borderSize));
-        r.setPosition(getPosition()); r.move({(float)Theme::borderSize, (float)Theme::borderSize});
-*/
-        sf::RectangleShape r(sf::Vector2f(getSize().x, getSize().y));
-        r.setPosition(getPosition());
-
-        r.setFillColor(m_tintColor.value());
-        r.setOutlineThickness(0);
-        target.draw(r, states);
-    }
+    draw(gfx::RenderContext{target, states});
 }
 
 template <class T>
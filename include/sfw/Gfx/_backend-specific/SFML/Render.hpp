@@ -4,6 +4,20 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+#include <functional>
+#include <vector>
+#include <optional>
+#include <type_traits>
+#include <cstddef> // size_t
+#include <cstdint>
 
 namespace sfw::gfx
 {
@@ -12,6 +26,41 @@ struct SFML //!!extend into some proper backend representation later
 {
 };
 
+class Drawable;
+class Renderer;
+
+//----------------------------------------------------------------------------
+// Translation-only transform
+//
+// Widgets are only ever positioned (not rotated or scaled), so they don't
+// need to carry a full matrix. Applying this to a (general) sf::Transform,
+// as `transform *= translation`, only updates its translation column (just
+// a few mul-adds), instead of a full matrix product.
+// (Anything else (i.e. client code) that actually needs rotation or scaling
+// can keep using sf::Transform directly.)
+//
+struct Translation
+{
+	sf::Vector2f offset;
+
+	operator sf::Transform() const { return sf::Transform(1, 0, offset.x,  0, 1, offset.y,  0, 0, 1); }
+};
+
+inline sf::Transform& operator*=(sf::Transform& t, const Translation& tr)
+{
+	// t * translation (see the sf::Transform ctor for the (column-major) layout)
+	const float* m = t.getMatrix();
+	auto [x, y] = tr.offset;
+	t = sf::Transform(m[0], m[4], m[0] * x + m[4] * y + m[12],
+	                  m[1], m[5], m[1] * x + m[5] * y + m[13],
+	                  m[3], m[7], m[3] * x + m[7] * y + m[15]);
+	return t;
+}
+
+
+// Set up GL scissoring for `target` (rect. in target pixel coordinates, top-left
+// origin), or disable it, if `rect` is std::nullopt
+void applyClipRect(sf::RenderTarget& target, const std::optional<sf::IntRect>& rect);
 
 //----------------------------------------------------------------------------
 template <>
@@ -20,6 +69,31 @@ struct RenderContext_base<SFML>
 	sf::RenderTarget& target;
 //	const sf::RenderStates& props;
 	sf::RenderStates props; // Allow adjusting this in-place!
+	Renderer* renderer = nullptr; // Optional: if set, draw requests are batched, instead of sent directly to `target`
+	std::optional<sf::IntRect> clip = std::nullopt; // Clip rect. for everything drawn via this context (in target pixels, top-left origin)
+
+	// Clipping
+	//
+	// The clip "stack" is the chain of nested contexts: clipped() "pushes" a
+	// new clip rect. by returning a copy of this context, with `clip` narrowed
+	// down to (the intersection with) `rect`, given in the local coordinates
+	// of `props.transform`. "Popping" it is just going on with the original
+	// context.
+	// (With a renderer, the clip rect. is resolved once per batch; without
+	// one, it's applied around each draw call.)
+	RenderContext_base clipped(const sf::FloatRect& rect) const;
+
+	// Drawing helpers that go via the renderer, if there's one, or directly
+	// to the target otherwise
+	//
+	// NOTE: objects that can't be batched (i.e. everything that's not either
+	//       raw vertices, or a gfx::Drawable sending raw vertices) are only
+	//       queued by reference, and drawn when the renderer flushes, so they
+	//       must be kept alive (and unchanged) until the end of the frame!
+	inline void draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) const;
+	inline void draw(const Drawable& object, const sf::RenderStates& states) const;
+	template <class T> requires (std::is_base_of_v<sf::Drawable, T> && !std::is_base_of_v<Drawable, T>)
+	void draw(const T& object, const sf::RenderStates& states) const;
 };
 
 using RenderContext = RenderContext_base<SFML>;
@@ -35,6 +109,7 @@ class Drawable : public Drawable_base<SFML>, public sf::Drawable
 //       So, implementing the sf::Drawable interface would do *NOTHING* for SFW!
 {
 friend class Layout;
+friend struct RenderContext_base<SFML>;
 protected:
     void draw([[maybe_unused]] sf::RenderTarget& target,
               [[maybe_unused]] const sf::RenderStates& states) const override {} // It's optional now...
@@ -46,13 +121,167 @@ protected:
 
 
 //============================================================================
+// Batching renderer
+//
+// Collects the geometry of a frame into as few vertex arrays as possible
+// (one per texture (+ other render states) and clip rect., ideally), and
+// draws them on flush().
+//
+// Objects that can't be batched (like text) are queued as-is, and drawn in
+// their original order, relative to each other, too.
+//
+// Geometry is allowed to "jump ahead" into an earlier batch (i.e. be drawn
+// earlier than submitted) only if nothing queued after that batch overlaps
+// it. This is checked with a coarse "Z-grid" covering the target, recording
+// the last draw command touching each cell, so the original painting order
+// (i.e. the Z-order) is always preserved, where it matters.
+//
 class Renderer : public Renderer_base<SFML>
 {
 public:
-    void render(const Drawable& object, const RenderContext& ctx);
+	// Start a new frame for `target` (discarding anything queued, but not yet flushed)
+	void begin(sf::RenderTarget& target);
+
+	// Queue vertices (transformed by `states`) for batched drawing
+	// Only triangle primitives can be batched; anything else would just flush
+	// the queue and get drawn immediately.
+	void submit(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states);
+
+	// Queue an SFML object that can't be batched, by reference (so it must
+	// stay alive, unchanged, until flush()!)
+	template <class T>
+	void submit(const T& object, const sf::RenderStates& states)
+	{
+		if constexpr (requires { object.getGlobalBounds(); })
+			queue(object, states, states.transform.transformRect(object.getGlobalBounds()));
+		else
+			queue(object, states, {});
+	}
+
+	// Set the clip rect. (in target pixel coordinates, top-left origin) for
+	// everything submitted after this call; std::nullopt to disable clipping
+	// (RenderContext::draw() does this automatically from its clip stack.)
+	void setClipRect(const std::optional<sf::IntRect>& rect) { m_clipRect = rect; }
+	const std::optional<sf::IntRect>& getClipRect() const { return m_clipRect; }
+
+	// Draw everything queued so far (in Z-order), then reset the queue
+	void flush();
+
+	// Number of draw calls issued by the last flush()
+	size_t drawCalls() const { return m_drawCalls; }
+
+private:
+	struct Command
+	{
+		const sf::Drawable* object; // Unbatched object, or null for a vertex batch
+		sf::RenderStates states;    // Just texture & co. (but no transform) for batches
+		size_t batch;               // Index in m_batches, for batches
+		std::optional<sf::IntRect> clip;
+	};
+
+	void reset(); // Clear the queue (but not the current target, clip rect. etc.)
+	void queue(const sf::Drawable& object, const sf::RenderStates& states, const std::optional<sf::FloatRect>& bounds);
+
+	bool batchable(const Command& cmd, const sf::RenderStates& states) const;
+
+	// Z-grid helpers (null bounds means "everywhere")
+	size_t topmost(const std::optional<sf::FloatRect>& bounds) const;
+	void cover(const std::optional<sf::FloatRect>& bounds, size_t z);
+	void cellRange(const sf::FloatRect& bounds, unsigned& x0, unsigned& y0, unsigned& x1, unsigned& y1) const;
+
+	static constexpr unsigned ZGRID_CELL_SIZE = 32; // px
+
+	sf::RenderTarget* m_target = nullptr;
+	std::vector<Command> m_commands;
+	std::vector<size_t> m_batchCommands; // Indexes of the batch commands in m_commands
+	std::vector<sf::VertexArray> m_batches; // Reused across frames, to avoid reallocations
+	size_t m_batchesUsed = 0;
+	std::vector<uint32_t> m_zgrid; // 1 + index of the last command covering each cell (0: none)
+	unsigned m_zgridCols = 0, m_zgridRows = 0;
+	std::optional<sf::IntRect> m_clipRect;
+	size_t m_drawCalls = 0;
+};
+
+
+//============================================================================
+// Offscreen layer
+//
+// A render texture that is painted (via its own batching renderer) only on
+// request, and can be drawn as a single textured quad in between, e.g. for
+// "caching as bitmap" subtrees that rarely change.
+//
+class Layer
+{
+public:
+	using Painter = std::function<void(const RenderContext&)>;
+
+	// (Re)paint the layer: `paint` gets a context for drawing in layer-local
+	// coordinates, (0, 0) being the top-left corner of the texture
+	// Returns false if the texture couldn't be (re)created for `size`.
+	bool paint(sf::Vector2f size, const Painter& paint);
+
+	// Shift the painted content by `offset` (rounded to whole pixels), and
+	// only repaint the uncovered strip(s) (`paint` gets a context clipped to
+	// each of them), instead of the whole layer
+	// Returns false (leaving the layer unchanged) if there's nothing to keep,
+	// i.e. it's not painted yet, or the offset is too large; it should be
+	// fully repainted then.
+	bool scroll(sf::Vector2f offset, const Painter& paint);
+
+	// Draw the last painted content (a no-op if not painted yet)
+	void draw(const RenderContext& ctx, const sf::RenderStates& states) const;
+
+	bool painted() const { return m_painted; }
+
+private:
+	// Front & back buffers, for scroll(); only the front one is painted
+	// otherwise (the back one is only created on the first scroll()).
+	sf::RenderTexture m_textures[2];
+	unsigned m_front = 0;
+	Renderer m_renderer;
+	sf::Vertex m_quad[4];
+	bool m_painted = false;
 };
 
 
+//----------------------------------------------------------------------------
+void RenderContext_base<SFML>::draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) const
+{
+	if (renderer)
+	{
+		renderer->setClipRect(clip);
+		renderer->submit(vertices, count, type, states);
+	}
+	else
+	{
+		if (clip) applyClipRect(target, clip);
+		target.draw(vertices, count, type, states);
+		if (clip) applyClipRect(target, std::nullopt);
+	}
+}
+
+void RenderContext_base<SFML>::draw(const Drawable& object, const sf::RenderStates& states) const
+{
+	object.draw(RenderContext{target, states, renderer, clip});
+}
+
+template <class T> requires (std::is_base_of_v<sf::Drawable, T> && !std::is_base_of_v<Drawable, T>)
+void RenderContext_base<SFML>::draw(const T& object, const sf::RenderStates& states) const
+{
+	if (renderer)
+	{
+		renderer->setClipRect(clip);
+		renderer->submit(object, states);
+	}
+	else
+	{
+		if (clip) applyClipRect(target, clip);
+		target.draw(object, states);
+		if (clip) applyClipRect(target, std::nullopt);
+	}
+}
+
+
 } // namespace sfw::gfx
 
 #endif // SFW_RENDER_SFML_HPP
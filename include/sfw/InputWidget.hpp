@@ -53,7 +53,7 @@ public:
 	// - set(V value); // Will call changed() as applicable
 	// - V get();
 	bool changed() const { return m_changed; }
-	Widget* setChanged(bool newstate = true) { m_changed = newstate; return this; }
+	Widget* setChanged(bool newstate = true) { m_changed = newstate; if (newstate) invalidate(); return this; }
 		//!!Rename this to a) not be so ambiguous with the above (const) one, and
 		//!!b) be in line with other similar ones (like enable/disable etc.)!...
 		//!!But change() here would be awkward -- even resorting to setChanged()
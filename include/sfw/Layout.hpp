@@ -2,8 +2,12 @@
 #define _SFW_LAYOUT_HPP_
 
 #include "sfw/WidgetContainer.hpp"
+#include "sfw/Gfx/Render.hpp"
+#include "sfw/Geometry.hpp"
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace sfw
 {
@@ -23,6 +27,16 @@ public:
 	bool focused() const override;
 	void unfocus(); // Remove focus from the focused child (recursively)
 	                // Made public to support apps with multiple GUI panels/windows (#368)
+
+	// "Cache as bitmap": render the children into an offscreen texture, and
+	// then just draw that (as a single quad), until something changes in the
+	// subtree (see Widget::invalidate()).
+	// Can save a lot of drawing for large, mostly static layouts (like long
+	// forms), but costs a texture of the size of the layout, and a full
+	// repaint of it on every change, so it's off by default.
+	Layout* setCacheAsBitmap(bool enable = true);
+	bool cachedAsBitmap() const { return (bool)m_cache; }
+
 protected:
 	Layout();
 
@@ -31,12 +45,41 @@ protected:
 	// Set the focus on a child widget, if applicable
 	// Returns true if the widget took the focus, otherwise false.
 	bool focus(Widget* widget);
+	Widget* focusedChild() const { return m_focusedWidget; }
+	Widget* hoveredChild() const { return m_hoveredWidget; }
 	bool focusNext();
 	bool focusPrevious();
 
 	void hover(Widget* widget, float parent_x, float parent_y); //!! The coords. are a kludge for tooltip support...
 	void unhover(); // Unhover last hovered child
 
+	// Find the (first enabled) child at `pos` (in layout-local coordinates),
+	// or null if none
+	Widget* childAt(const sf::Vector2f& pos) const;
+
+	// Hit-test index
+	// Layouts that position their children along an axis, in list order (like
+	// HBox, VBox or Form), should call this at the end of recomputeGeometry(),
+	// to let childAt() (i.e. resolving the hovered child) do a binary search,
+	// instead of checking every child.
+	// Without an index (or while the layout is pending), childAt() just falls
+	// back to scanning the children. (Note: moving children directly, other
+	// than by the layout itself, would leave the index stale!)
+	void indexChildren(Orientation axis);
+
+	// Reposition a child without invalidating anything, for when only where
+	// it's shown changes, but not how it looks (like when scrolling)
+	// The caller is responsible for getting the new placement drawn!
+	void moveChild(Widget* child, const sf::Vector2f& pos);
+
+	// Draw the children (with `lctx` already in layout-local coordinates)
+	// If `lctx` has a clip rect., children entirely outside of it are skipped
+	// (assuming that widgets don't draw outside of their own rect.).
+	void draw_children(const gfx::RenderContext& lctx) const;
+
+	// Drop the hovered/focused etc. state of a child being detached
+	void forget_child(Widget* child) override;
+
 // ---- Callbacks ------------------------------------------------------------
 	void draw(const gfx::RenderContext& ctx) const override;
 
@@ -49,9 +92,23 @@ protected:
 	void onKeyReleased(const sf::Event::KeyEvent& key) override;
 	void onTextEntered(char32_t unichar) override;
 
+	std::unique_ptr<gfx::Layer> m_cache; // Only if cached as bitmap
+
 private:
 	Widget* m_hoveredWidget;
 	Widget* m_focusedWidget;
+
+	// The hit-test index: the extents of the children along m_hitAxis,
+	// in list (and position) order
+	struct HitSpan
+	{
+		float from, to;
+		float reach; // The max. `to` up to (and including) this one, to handle overlaps
+		Widget* widget;
+	};
+	std::vector<HitSpan> m_hitIndex;
+	Orientation m_hitAxis;
+	static constexpr size_t HIT_INDEX_MIN_CHILDREN = 16; // Not worth it for fewer
 };
 
 } // namespace
@@ -12,6 +12,22 @@
 	W* add(const std::string& label, W&& tmpWidget, const std::string& name = "")
 		{ return (W*)(Widget*)add(label, (Widget*)new W(std::move(tmpWidget)), name); }
 
+	//
+	// emplace<MyRealWidget>("label", args...) -> MyRealWidget*
+	//
+	// Like add("label", MyRealWidget(args...)), but without the temporary (the
+	// widget is constructed in place)
+	// (Note: this hides WidgetContainer::emplace(), as all the form rows must
+	// have labels.)
+	//
+	template <class W, typename... Args> requires (std::is_base_of_v<Widget, W>)
+	W* emplace(const std::string& label, Args&&... args)
+		{ return (W*)(Widget*)add(label, (Widget*)new W(std::forward<Args>(args)...)); }
+
+	template <class W, typename... Args> requires (std::is_base_of_v<Widget, W>)
+	W* emplaceNamed(const std::string& label, const std::string& name, Args&&... args)
+		{ return (W*)(Widget*)add(label, (Widget*)new W(std::forward<Args>(args)...), name); }
+
 
 	/*************************************************************************
 	* Same as above, but allowing any widget as "label"
@@ -0,0 +1,51 @@
+#ifndef GUI_SCROLLAREA_HPP
+#define GUI_SCROLLAREA_HPP
+
+#include "sfw/Layout.hpp"
+
+#include <SFML/System/Vector2.hpp>
+
+namespace sfw
+{
+
+/**
+ * Vertically stacked layout (like VBox), shown through a fixed-size viewport,
+ * scrolled with the mouse wheel (or programmatically)
+ *
+ * Children out of the viewport are not drawn (nor can they be hovered etc.).
+ *
+ * With setCacheAsBitmap(), the viewport is kept in a texture, and scrolling
+ * only repaints the newly uncovered strip of it.
+ */
+class ScrollArea: public Layout
+{
+public:
+	// If the width is 0, the viewport will follow the width of the content.
+	ScrollArea(sf::Vector2f viewportSize);
+
+	ScrollArea* setViewportSize(sf::Vector2f size);
+	const sf::Vector2f& viewportSize() const { return m_viewportSize; }
+
+	// Scroll position: the distance of the top of the viewport from the top
+	// of the content (clamped to the content, and rounded to whole pixels)
+	ScrollArea* scrollTo(float y);
+	ScrollArea* scroll(float dy) { return scrollTo(m_scroll + dy); }
+	float scrollPosition() const { return m_scroll; }
+	float contentHeight() const { return m_contentHeight; }
+
+private:
+	float max_scroll() const;
+
+	void recomputeGeometry() override;
+	void draw(const gfx::RenderContext& ctx) const override;
+	void onMouseWheelMoved(int delta) override;
+
+	sf::Vector2f m_viewportSize;
+	float m_contentHeight = 0;
+	float m_scroll = 0;
+	mutable float m_paintedScroll = 0; // Scroll pos. of the cached bitmap (if cached)
+};
+
+} // namespace
+
+#endif // GUI_SCROLLAREA_HPP
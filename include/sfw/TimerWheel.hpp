@@ -0,0 +1,98 @@
+#ifndef _SFW_TIMERWHEEL_HPP_
+#define _SFW_TIMERWHEEL_HPP_
+
+#include <functional>
+#include <vector>
+#include <optional>
+#include <cstddef> // size_t
+#include <cstdint>
+
+namespace sfw
+{
+
+/*****************************************************************************
+   Hierarchical timing wheel, for scheduling one-shot and periodic timers
+
+   Time is measured in (integer) ticks; the client decides how long a tick
+   is, and advances the wheel to the current tick with advance(), which then
+   fires whatever has become due.
+
+   Starting or stopping a timer is O(1), and so is advancing by one tick,
+   plus the cost of the timers fired (or moved down to a finer level of the
+   wheel) by it. Stretches of time with nothing due are skipped wholesale,
+   so an (almost) empty wheel costs next to nothing to advance, no matter
+   how much time has passed.
+
+   The levels (from the finest): 256 slots of 1 tick, then 3 x 64 slots of
+   256, 16K and 1M ticks, resp. Timers due even later than that are parked
+   in the last level, and are just re-parked until they get close enough.
+
+   Callbacks can start or stop any timers (including their own).
+   Note: not thread-safe.
+ *****************************************************************************/
+class TimerWheel
+{
+public:
+	using Tick = std::uint64_t;
+	using Callback = std::function<bool()>; // Return false to stop a periodic timer
+
+	struct Id
+	{
+		std::uint32_t index = 0;
+		std::uint32_t generation = 0; // 0: null ID
+		explicit operator bool() const { return generation != 0; }
+	};
+
+	// Fire `callback` at tick `due` (or at the next advance(), if that's
+	// already past), and then in every `period` ticks, unless it's 0
+	Id start(Tick due, Tick period, Callback callback);
+	bool stop(Id id); // false if it's not pending (anymore)
+	bool pending(Id id) const;
+
+	// Fire everything due up to (and including) `now`
+	void advance(Tick now);
+
+	// The earliest due tick of the pending timers (not earlier than the next
+	// one to be processed), or nullopt if there are none
+	std::optional<Tick> nextDue() const;
+
+	std::size_t size() const { return m_count; }
+
+private:
+	static constexpr unsigned LEVELS = 4;
+	static constexpr unsigned L0_BITS = 8, LN_BITS = 6;
+	static constexpr Tick L0_SIZE = Tick(1) << L0_BITS, LN_SIZE = Tick(1) << LN_BITS;
+	static constexpr Tick L0_MASK = L0_SIZE - 1, LN_MASK = LN_SIZE - 1;
+	static constexpr unsigned shift(unsigned level) { return level ? L0_BITS + (level - 1) * LN_BITS : 0; }
+	static constexpr Tick MAX_SPAN = Tick(1) << (L0_BITS + (LEVELS - 1) * LN_BITS); // Beyond this, timers are parked
+
+	struct Timer
+	{
+		Callback callback;
+		Tick due = 0;
+		Tick period = 0;
+		std::uint32_t generation = 1;
+		std::int32_t prev = -1, next = -1; // Slot list links
+		std::uint8_t level = 0;
+		std::uint16_t slot = 0;
+		bool active = false;
+	};
+
+	void link(std::uint32_t index);   // Put in the slot matching its due tick
+	void unlink(std::uint32_t index); // Take out of its slot
+	void release(std::uint32_t index);
+	void cascade(unsigned level, std::size_t slot); // Move a slot one level down
+	void fire(std::uint32_t index);
+
+	std::vector<Timer> m_timers;
+	std::vector<std::uint32_t> m_free;
+	std::vector<std::int32_t> m_slots[LEVELS]; // List heads (-1: empty)
+	std::size_t m_levelCount[LEVELS] = {};
+	std::size_t m_count = 0;
+	Tick m_current = 0; // The next tick to be processed
+	std::int32_t m_firing = -1; // The timer whose callback is running (if any)
+};
+
+} // namespace
+
+#endif // _SFW_TIMERWHEEL_HPP_
@@ -0,0 +1,118 @@
+#ifndef _SFW_VALUECHANNEL_HPP_
+#define _SFW_VALUECHANNEL_HPP_
+
+#include <atomic>
+#include <type_traits>
+#include <cstring> // memcpy
+#include <cstddef> // size_t
+#include <cstdint>
+
+namespace sfw
+{
+
+/*****************************************************************************
+   Lock-free "latest value" slot, for feeding output widgets from other threads
+
+   Producers can store() at any rate, from any number of threads, without
+   ever blocking (or being blocked by) the reader: each store just overwrites
+   the previous value, so nothing is queued up, however slow the reader is.
+   The reader (typically a widget, sampling it once per frame; see e.g.
+   ProgressBar::bind()) always gets the latest complete value.
+
+   Implemented as a seqlock: the sequence counter is odd while a store is in
+   progress, and readers retry if it was odd, or changed during their read.
+   (Concurrent stores are serialized by briefly spinning on the counter.)
+   The value is copied in machine words, via relaxed atomics, so T must be
+   trivially copyable (and should be small: it's copied on every load).
+
+   Share it between the producer(s) and the widget(s) with a shared_ptr.
+ *****************************************************************************/
+template <class T>
+	requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class ValueChannel
+{
+public:
+	ValueChannel(const T& initial = T{}) { write_words(initial); }
+	ValueChannel(const ValueChannel&) = delete;
+
+	// Any thread(s)
+	void store(const T& value)
+	{
+		auto seq = m_seq.load(std::memory_order_relaxed);
+		for (;;) // Grab the writer "lock", by making the counter odd
+		{
+			if (!(seq & 1) && m_seq.compare_exchange_weak(seq, seq + 1, std::memory_order_relaxed))
+				break;
+			seq = m_seq.load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_release); // Keep the data stores after the odd counter
+		write_words(value);
+		m_seq.store(seq + 2, std::memory_order_release);
+	}
+
+	// Any thread
+	T load() const
+	{
+		T value;
+		std::uint64_t version = 0;
+		while (!try_load(value, version, SPIN_LIMIT)) {}
+		return value;
+	}
+
+	// Load the value only if it has been stored since `version` (which is then
+	// updated to the current one); returns false (leaving `value` as-is) if not
+	// (Start with version 0 to always get the first one.)
+	// Never blocks for long: if the producers keep it busy, it just gives up
+	// (returning false), so a reader sampling it per frame can try again later.
+	bool load_if_changed(T& value, std::uint64_t& version) const
+	{
+		return try_load(value, version, SPIN_LIMIT);
+	}
+
+	static constexpr unsigned SPIN_LIMIT = 64; // Max. retries of load_if_changed()
+
+private:
+	bool try_load(T& value, std::uint64_t& version, unsigned tries) const
+	{
+		while (tries--)
+		{
+			auto seq = m_seq.load(std::memory_order_acquire);
+			if (seq & 1) continue; // A store is in progress
+			if (seq / 2 + 1 == version) return false; // (Counted from 1, so 0 is never current)
+
+			T tmp = read_words();
+			std::atomic_thread_fence(std::memory_order_acquire); // Keep the data loads before the recheck
+			if (m_seq.load(std::memory_order_relaxed) != seq) continue; // Torn: retry
+
+			value = tmp;
+			version = seq / 2 + 1;
+			return true;
+		}
+		return false;
+	}
+
+	static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::size_t) - 1) / sizeof(std::size_t);
+
+	void write_words(const T& value)
+	{
+		std::size_t buf[WORDS] = {};
+		std::memcpy(buf, &value, sizeof(T));
+		for (std::size_t i = 0; i < WORDS; ++i) m_data[i].store(buf[i], std::memory_order_relaxed);
+	}
+
+	T read_words() const
+	{
+		std::size_t buf[WORDS];
+		for (std::size_t i = 0; i < WORDS; ++i) buf[i] = m_data[i].load(std::memory_order_relaxed);
+		T value;
+		std::memcpy(&value, buf, sizeof(T));
+		return value;
+	}
+
+	std::atomic<std::uint64_t> m_seq = 0;
+	std::atomic<std::size_t> m_data[WORDS];
+};
+
+} // namespace
+
+#endif // _SFW_VALUECHANNEL_HPP_
@@ -33,6 +33,14 @@ namespace sfw
 		template <typename ...Ts>
 		struct last_arg { using type = typename decltype((std::type_identity<Ts>{}, ...))::type; };
 
+		// Lookup cache of a "name"_W literal (one per literal; see ConstString)
+		struct ResolvedName
+		{
+			Widget* widget = nullptr;
+			std::size_t generation = 0; // Valid if == name_registry_generation
+		};
+		template <auto ConstName> inline ResolvedName resolved_name;
+
 	/*
 		template <typename... Args> requires(sizeof...(Args) >= 1)
 		decltype(auto) constexpr last_arg_cref(const Args&... args)
@@ -215,6 +223,59 @@ decltype(auto) operator << (auto& out, const sfw::WidgetPtr<W>& wptr)
 	{ return out <<"#"<<std::hex<<(void*)&wptr; }
 
 
+//----------------------------------------------------------------------------
+// Generational widget handle
+//
+// Unlike WidgetPtr (or raw pointers), this can be safely kept around (and
+// copied etc.) after the widget has been deleted (e.g. by
+// WidgetContainer::remove()): it will just resolve to null then.
+// Resolving is O(1) (a table lookup), with no name lookups involved.
+//
+// Usage:
+//
+//	WidgetHandle<Label> status = container.add(Label("..."));
+//	...
+//	if (auto* label = status.get(); label) label->setText("Done.");
+//
+template <std::derived_from<Widget> W = Widget>
+class WidgetHandle
+{
+public:
+	WidgetHandle() = default; // Null handle
+	WidgetHandle(const W* w) { if (w) _id = w->getHandleId(); }
+
+	// Null, if the widget is gone (or this is a null handle)
+	W* get() const { return (W*) Widget::fromHandleId(_id); }
+	explicit operator bool() const { return get() != nullptr; }
+
+	// Guarded calls, like with WidgetPtr (a no-op, returning unexpected, if
+	// the widget is gone)
+	template <auto Method, typename... Args>
+	auto call(Args&&... args) const
+		-> std::expected<
+			typename internal::deduce_rettype_from_mfp<decltype(Method)>::type,
+			std::nullptr_t
+		>
+	{
+		using WReq = internal::deduce_class_from_mfp<decltype(Method)>::type;
+		static_assert(std::derived_from<WReq, Widget>);
+
+		if (auto wptr = (WReq*)get(); wptr) {
+			return std::invoke(Method, *wptr, std::forward<Args>(args)...);
+		} else {
+			return std::unexpected(nullptr);
+		}
+	}
+
+	Widget::HandleId id() const { return _id; }
+	bool operator == (const WidgetHandle& other) const {
+		return _id.slot == other._id.slot && _id.generation == other._id.generation; }
+
+protected:
+	Widget::HandleId _id;
+};
+
+
 
 //============================================================================
 // Widget lookup - Legacy convenience API...
@@ -289,6 +350,8 @@ WidgetPtr<W> getWidget(std::string_view name) { return WidgetPtr( (W*)Widget::ge
 	{                  //!! user-defined!) string literal template parameters... :-/
 		char literal_name[N+1] = {0};
 		WType* wptr = nullptr;
+		std::size_t hash = 0; // Precomputed for the name registry
+		internal::ResolvedName* cache = nullptr; // Set by operator""_W
 
 		constexpr ConstString(char const(&cstr)[N])
 		{
@@ -296,6 +359,7 @@ WidgetPtr<W> getWidget(std::string_view name) { return WidgetPtr( (W*)Widget::ge
 			//!!std::ranges::copy(cstr, literal_name);
 			//!! So...:
 			for (auto outp = literal_name; auto c : cstr) *outp++ = c;
+			hash = internal::name_hash(literal_name); // (N includes the terminating 0!)
 #if 0 // I just couldn't make it consteval'ed:
 			/*!! Can't constexpr this...!!*/ auto outp = literal_name;
 			for (auto c : cstr) *outp++ = c;
@@ -310,11 +374,26 @@ WidgetPtr<W> getWidget(std::string_view name) { return WidgetPtr( (W*)Widget::ge
 		constexpr operator std::string      () const { return std::string(literal_name); }
 		constexpr operator std::string_view () const { return std::string_view(literal_name); }
 
+		// Look up the widget, or just return it from the cache, if the name
+		// registry hasn't changed since the last lookup
+		Widget* resolve() const
+		{
+			if (!cache)
+				return Widget::getWidget_proxy(internal::HashedName{literal_name, hash});
+
+			if (cache->generation != internal::name_registry_generation)
+			{
+				cache->widget = Widget::getWidget_proxy(internal::HashedName{literal_name, hash});
+				cache->generation = internal::name_registry_generation;
+			}
+			return cache->widget;
+		}
+
 		template <class AnyWidget>
 		constexpr operator AnyWidget* ()
 		// To support this syntax: ((TextBox*)"some name"_W)->set("It works!")
 		{
-			wptr = getWidget<AnyWidget>(literal_name); //!! Only via the last gui instance yet! :-/
+			wptr = (WType*) resolve(); //!! Only via the last gui instance yet! :-/
 			return (AnyWidget*) wptr;
 		}
 
@@ -322,7 +401,7 @@ WidgetPtr<W> getWidget(std::string_view name) { return WidgetPtr( (W*)Widget::ge
 		constexpr operator AnyWidget& ()
 		// To support this syntax: ((TextBox&)"some name"_W).set("It works!")
 		{
-			wptr = getWidget<AnyWidget>(literal_name); //!! Only via the last gui instance yet! :-/
+			wptr = (WType*) resolve(); //!! Only via the last gui instance yet! :-/
 			return (AnyWidget&) *wptr;
 		}
 /*
@@ -350,8 +429,8 @@ WidgetPtr<W> getWidget(std::string_view name) { return WidgetPtr( (W*)Widget::ge
 			using W = internal::deduce_class_from_mfp<decltype(Method)>::type;
 			static_assert(std::derived_from<W, Widget>);
 
-			WidgetPtr<W> typed_wptr = getWidget<W>(literal_name);
-			wptr = typed_wptr; // Set this too...
+			WidgetPtr<W> typed_wptr = (W*) resolve();
+			wptr = (WType*) typed_wptr; // Set this too...
 
 			if (typed_wptr) {
 				auto&& method{Method}; // Yet some more cryptic C++ bullshit, sorry! ;)
@@ -368,7 +447,13 @@ WidgetPtr<W> getWidget(std::string_view name) { return WidgetPtr( (W*)Widget::ge
 	};
 		
 	template<ConstString s> //!! C++ forbids parametrizing by another type: no "..."_W<Button> :-/
-	constexpr auto operator""_W() { return s; };
+	constexpr auto operator""_W()
+	{
+		// Each distinct literal gets its own lookup cache:
+		auto named = s;
+		named.cache = &internal::resolved_name<s>;
+		return named;
+	};
 
 //----------------------------------------------------------------------------
 // Universal widget manipulator proxy
@@ -420,11 +505,25 @@ decltype(auto) apply(const char* name, Args&&... args)
 //
 //	apply_W<"widget name"_W, &CheckBox::set>(new_value);
 //
+// The lookup is cached (per literal), so this is cheap enough even for
+// updating widgets in every frame.
+//
 template<auto ConstName, auto SpecificMethod, typename... Args> //!!C++: Vanilla string literals (e.g. const char*) can't be template args! :-/
-decltype(auto) apply_W(Args&&... args)
+auto apply_W(Args&&... args)
+	-> std::expected<
+		typename internal::deduce_rettype_from_mfp<decltype(SpecificMethod)>::type,
+		std::nullptr_t
+	>
 {
-	using Method = decltype(SpecificMethod); //!!C++: decltype's required for concepts? (as opposed to causing problems if used with `typename` args!) :-o
-	return with<Method, Args...>(ConstName.literal_name, SpecificMethod, std::forward<Args>(args)...);
+	using W = internal::deduce_class_from_mfp<decltype(SpecificMethod)>::type;
+	static_assert(std::derived_from<W, Widget>);
+
+	if (auto wptr = (W*) ConstName.resolve(); wptr) {
+		return std::invoke(SpecificMethod, *wptr, std::forward<Args>(args)...);
+	} else {
+		// The lookup is expected to have already freaked out on null!...
+		return std::unexpected(nullptr);
+	}
 }
 
 
@@ -10,12 +10,16 @@
 //!!#include "sfw/GUI-main.hpp"        // See forw. decl. below instead...
 
 #include "sfw/Gfx/Render.hpp"
+#include "sfw/TimerWheel.hpp"
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Window/Event.hpp>
 
 #include <string_view>
+#include <cstddef> // size_t
+#include <new> // align_val_t
+#include <cstdint>
 //!!LEGACY:
 #include <string> // (Other widget headers are exempt from reincluding this.)
 
@@ -33,6 +37,37 @@ class Layout;
 class Tooltip;
 class GUI;
 
+namespace internal
+{
+	// Hash for widget names: FNV-1a, so it can also be computed at compile
+	// time, for "name"_W literals (see ConstString in Widget.hpp), which can
+	// then be looked up without rehashing them (see HashedName).
+	constexpr std::size_t name_hash(std::string_view name)
+	{
+		if constexpr (sizeof(std::size_t) >= 8) {
+			std::uint64_t h = 14695981039346656037ull;
+			for (unsigned char c : name) { h ^= c; h *= 1099511628211ull; }
+			return (std::size_t)h;
+		} else {
+			std::uint32_t h = 2166136261u;
+			for (unsigned char c : name) { h ^= c; h *= 16777619u; }
+			return (std::size_t)h;
+		}
+	}
+
+	// Name registry lookup key with a precomputed hash
+	struct HashedName
+	{
+		std::string_view name;
+		std::size_t hash;
+	};
+
+	// Bumped on every change that may affect any name lookups (i.e. (re)naming
+	// widgets, or replacing the default GUI), so that cached lookup results
+	// can be validated with a single compare
+	inline std::size_t name_registry_generation = 1;
+}
+
 /*****************************************************************************
 
     Abstract (not in the C++ sense!) base for widgets
@@ -77,19 +112,40 @@ public:
 	//   (Note: while widgets are not copied/moved after being added to the GUI,
 	//   they can be during setup.)
 	//
+	// - A widget can have multiple names (aliases); getName() returns the latest.
+	//
 	// - If the name has already been assigned to another widget, the newly named
-	//   widget will win, stealing the name from the other widget, which will then
-	//   revert to having a default ID instead.
+	//   widget will win, stealing the name from the other widget (which keeps its
+	//   other names, if any, or reverts to having a default ID).
 	//   (Perhaps unsurprisingly, this behavior might change in the future. ;) )
 	void setName(const std::string&);
 
 	// Get the optional name of a widget (or its internal ID, if unnamed)
 	// If a widget is specified then that one will be looked up, not the current one.
-	// Note: This may be a slow operation (intended mainly for diagnostics).
+	// (Unnamed widgets get their default ID generated on the fly.)
 	std::string getName(Widget* widget = nullptr) const;
 
 	Widget* setTooltip(const std::string& text);
 
+	// Mark the widget as changed, to be redrawn by the next GUI::render()
+	// (The flag rolls up to the GUI (see GUI::needsRedraw()). Setters etc.
+	// call this automatically; it's only needed for changes the widget can't
+	// know about, like animating a DrawHost via its hook.)
+	void invalidate();
+	bool dirty() const { return m_dirty; }
+
+	// Generational handle support (see WidgetHandle for the typed interface)
+	// A handle is a (slot, generation) pair that can be resolved in O(1), and
+	// remains safe to use after the widget has been deleted: it just resolves
+	// to null then. (Slots are only assigned on the first request.)
+	struct HandleId
+	{
+		std::uint32_t slot = 0;
+		std::uint32_t generation = 0; // Never 0 for a valid handle
+	};
+	HandleId getHandleId() const;
+	static Widget* fromHandleId(HandleId id);
+
 protected:
 //----------------------
 friend class WidgetContainer;
@@ -102,6 +158,24 @@ friend class Tooltip; // just to access getMain() via Tooltip::m_owner->!
 public: //!! WidgetRef needs these:
 	Widget();
 	virtual ~Widget();
+
+#ifndef SFW_NO_WIDGET_POOL
+	// Widgets (and widget subclasses) are allocated from a size-class pool
+	// (see util/pool.hpp), sparing a malloc/free for each, and keeping the
+	// nodes of the same type packed together, for better locality when
+	// traversing the tree. (Define SFW_NO_WIDGET_POOL to use plain new.)
+	// Note: the pool is shared by all GUIs, and is not synchronized, so
+	// creating (or deleting) widgets on other threads than the GUI thread
+	// (e.g. preparing them on a worker) is a data race! Also, the memory of
+	// the deleted widgets is only reused by new ones, not returned to the
+	// system (until exit).
+	// (Over-aligned widget types, i.e. beyond the pool's alignment, are
+	// allocated with the global aligned new instead.)
+	static void* operator new(std::size_t size);
+	static void* operator new(std::size_t size, std::align_val_t align);
+	static void operator delete(void* p, std::size_t size) noexcept;
+	static void operator delete(void* p, std::size_t size, std::align_val_t align) noexcept;
+#endif
 protected:
 	//!! These two horrible, depressing monstrosities only temporarily, until default-friendly
 	//!! smart pointers are introduced (which will need valgrind etc. tests with raw pointers);
@@ -120,6 +194,15 @@ protected:
 	void setFocusable(bool focusable); //!!setInteractive, as it's all about taking user inputs!
 	bool focusable() const;
 
+	// Subscribe to (or unsubscribe from) getting onTick() called on every frame
+	// Widgets are not ticked otherwise, so only request this while actually
+	// animating something, and prefer GUI timers (see GUI::startTimer()) for
+	// anything that's not changing on every frame.
+	// With an `interval` (s), it's ticked at that rate instead, by a periodic
+	// GUI timer, so it won't keep waking up the event loop on every frame
+	// (e.g. for sampling something at the display rate).
+	void requestTicks(bool enable = true, float interval = 0);
+
 	// Get the widget typed as a Layout, if applicable
 	virtual Layout* toLayout() { return nullptr; }
 	bool isLayout() { return toLayout() != nullptr; }
@@ -161,9 +244,41 @@ protected:
 	virtual void traverse(const std::function<void(Widget*)>&) {}
 	virtual void ctraverse(const std::function<void(const Widget*)>&) const {}
 
+protected:
+	// Mouse wheel routing: the wheel goes down the hover chain (see
+	// Layout::onMouseWheelMoved()), and any handler can decline it (the
+	// default one does), to let the containers up the chain use it instead
+	// (e.g. for scrolling)
+	void onMouseWheelMoved(int) override { decline_wheel(); }
+	static void decline_wheel() { s_wheelDeclined = true; }
+	static bool offer_wheel(Widget* widget, int delta); // false if declined
+
 private:
 	virtual void recomputeGeometry() {} // Also called by some of the friend classes
 
+	// setPosition() without invalidate() (for Layout::moveChild())
+	void set_position(const sf::Vector2f& pos);
+
+	// The placement of the widget in the tree (its absolute position, and
+	// the GUI it belongs to) is cached, to spare walking up to the root for
+	// every query. It's recalculated on demand (from the parent's), and reset
+	// for the entire subtree whenever the widget is moved or reparented.
+	// (Invariant: if a widget's cache is invalid, so is its descendants'.)
+	void reset_cached_placement();
+	void update_cached_placement() const;
+
+	// Invalidate the handles of the widget (on deletion)
+	void release_handle_slot();
+
+	// Call onTick() for the widgets of `main` that have requested it (see
+	// requestTicks()), and drop the unsubscribed (or deleted) ones
+	// (Also starts the timers of the ones subscribed with an interval.)
+	static void tick_subscribers(GUI* main);
+	static bool ticks_requested(const GUI* main); // Any subscribers (ticked on every frame)?
+	// Drop the tick timer (if any), to get a new one from whatever GUI the
+	// widget is added to next (see WidgetContainer::detach())
+	void rearm_ticks();
+
 	// -------- Callbacks... (See event.hpp for the generic ones!)
 	virtual void onActivationChanged(ActivationState) {}
 	virtual void onResized() {}
@@ -171,18 +286,28 @@ private:
 
 private:
 	WidgetContainer* m_parent = nullptr;
-	Widget* m_previous = nullptr;
-	Widget* m_next = nullptr;
+	std::size_t m_index = 0; // Position among the children of m_parent (if any)
+	bool m_isContainer = false; // Set by WidgetContainer (saves a virtual call per node in traversals)
 
 	bool m_focusable;
 	ActivationState m_activationState;
+	mutable bool m_dirty = true; // Cleared when drawn
 
 	sf::Vector2f m_position;
 	sf::Vector2f m_size;
-	sf::Transform m_transform;
+
+	mutable sf::Vector2f m_absPosition; // Cached; see update_cached_placement()!
+	mutable GUI* m_main = nullptr;      // Cached; see update_cached_placement()!
+	mutable bool m_placementCached = false;
 
 	Tooltip* m_tooltip = nullptr;
 
+	mutable std::uint32_t m_handleSlot = 0; // 1 + its slot in the handle table, or 0 if none yet
+	bool m_ticking = false; // See requestTicks()
+	static inline bool s_wheelDeclined = false; // See offer_wheel()
+	float m_tickInterval = 0; // 0: every frame
+	TimerWheel::Id m_tickTimer; // If ticked by a timer (not copied)
+
 #ifdef DEBUG
 public:
 	void draw_outline(const gfx::RenderContext& ctx, sf::Color outlinecolor = sf::Color::Red,
@@ -191,11 +316,12 @@ public:
 
 // ---- Misc. hackery... -----------------------------------------------------
 
-	// Rotation, scale and translation adjustments for the widget-local
-	// gfx. context, relative to the parent's
+	// Transform adjustments for the widget-local gfx. context, relative to
+	// the parent's: just a translation (to the widget's position) for now,
+	// as widgets can't be rotated or scaled (see gfx::Translation)
 	//!!Shouldn't really be public, or even exist, if we had a proper render-context API already...
 	public:
-	const sf::Transform& getTransform() const;
+	gfx::Translation getTransform() const { return {m_position}; }
 
 	// Internal helper to shield this header from some extra dependencies
 	// See the freestanding functions that need this, below the class!
@@ -210,6 +336,7 @@ public:
 	//
 	public:
 	static Widget* getWidget_proxy(std::string_view name, const Widget* w = nullptr);
+	static Widget* getWidget_proxy(const internal::HashedName& name, const Widget* w = nullptr);
 	// If w == null, try the global default (singleton) GUI manager.
 	// If w is set, use that to look up its actual manager object.
 
@@ -4,9 +4,14 @@
 #include "sfw/Widget.hpp"
 
 #include <string>
+#include <span>
+#include <initializer_list>
 #include <type_traits>
+#include <concepts>
 #include <utility>
 #include <functional>
+#include <vector>
+#include <cstddef> // size_t
 
 namespace sfw
 {
@@ -27,6 +32,22 @@ public:
 	W* add(W&& tmp_widget, const std::string& name = "")
 		{ return (W*)(Widget*)add((Widget*)new W(std::move(tmp_widget)), name); }
 
+	/**
+	 * Construct a new widget (of type W, from `args`) right in its final
+	 * place, and append it to the container
+	 * Unlike add(W(...)), this doesn't need a temporary widget to move from
+	 * (and then destroy).
+	 * Use emplaceNamed() to also give it a name.
+	 * @return Pointer to the new widget
+	 */
+	template <class W, typename... Args> requires std::is_base_of_v<Widget, W>
+	W* emplace(Args&&... args)
+		{ return (W*)(Widget*)add((Widget*)new W(std::forward<Args>(args)...)); }
+
+	template <class W, typename... Args> requires std::is_base_of_v<Widget, W>
+	W* emplaceNamed(const std::string& name, Args&&... args)
+		{ return (W*)(Widget*)add((Widget*)new W(std::forward<Args>(args)...), name); }
+
 	/**
 	 * Attach already existing widget created by the client (with new) to the container
 	 * The container will take care of deleting it.
@@ -55,23 +76,81 @@ public:
 	Widget* addAfter(Widget* anchor, Widget* widget, const std::string& name = "");
 	Widget* addAfter(const std::string& anchor_name, Widget* widget, const std::string& name = "");
 
-	// STL-like iteration helpers ----------------------------------------
-	bool empty() const { return !m_first; }
-	Widget* begin() const { return m_first; }
-	Widget* end() const { return nullptr; }
-	Widget* next(const Widget* w) const { return w ? w->m_next : end(); }
-	Widget* prev(const Widget* w) const { return w ? w->m_previous : end(); }
-	Widget* rend() const { return nullptr; }
-	Widget* rbegin() const { return m_last; }
-	//!! Make the entire class STL-compatible, so the std:: algorithms can be used on it! (#162)
-	//!! Requires an iterator class that begin/end can return, supporting op* and ++/-- etc.!
+	/**
+	 * Append a batch of already existing widgets (created by the client with
+	 * new), in this order (the container will take care of deleting them)
+	 * The named variant takes {widget, name} pairs (an empty name means no
+	 * name, like with add()).
+	 * This is much cheaper than adding them one by one: the registry is sized
+	 * up front, the names are registered in one pass, and the container gets
+	 * rearranged only once (by the next layout pass).
+	 * @return This container (for chaining)
+	 */
+	WidgetContainer* addMany(std::span<Widget* const> widgets);
+	WidgetContainer* addMany(std::span<const std::pair<Widget*, std::string>> named_widgets);
+	WidgetContainer* addMany(std::initializer_list<Widget*> widgets)
+		{ return addMany(std::span<Widget* const>(widgets.begin(), widgets.size())); }
+	WidgetContainer* addMany(std::initializer_list<std::pair<Widget*, std::string>> named_widgets)
+		{ return addMany(std::span<const std::pair<Widget*, std::string>>(named_widgets.begin(), named_widgets.size())); }
+
+	/**
+	 * Unlink a child (with all its descendants) from the container, without
+	 * deleting it
+	 * It's also cleaned up from the GUI: its name (and the names of its
+	 * descendants) will be forgotten, it won't stay hovered or focused,
+	 * its tooltips get cancelled etc. It can then be added again (to any
+	 * container).
+	 * @return The detached widget (now owned by the caller), or null, if
+	 * `widget` is not a child of this container
+	 */
+	Widget* detach(Widget* widget);
+
+	template <class W> requires std::is_base_of_v<Widget, W>
+	W* detach(W* widget)
+		{ return (W*) detach((Widget*)widget); }
+
+	/**
+	 * Detach and delete a child (with all its descendants)
+	 * If called during event dispatch (e.g. by a widget's own callback), it
+	 * is detached right away, but only deleted after GUI::process() is done
+	 * with the event.
+	 * @return false, if `widget` is not a child of this container
+	 */
+	bool remove(Widget* widget);
+
+	// Children (STL-compatible) ----------------------------------------
+	// The children are stored contiguously, in order, and the container is
+	// a (random-access) range of them, so it works with range-for, and the
+	// std::ranges algorithms, e.g.:
+	//
+	//	for (Widget* w : *container) ...
+	//	auto it = std::ranges::find_if(*container, [](Widget* w) { ... });
+	//
+	// (The iterators are to `Widget* const`: the children can be changed,
+	// but the container itself only via add(), detach() etc.)
+	using iterator         = std::vector<Widget*>::const_iterator;
+	using reverse_iterator = std::vector<Widget*>::const_reverse_iterator;
+
+	bool empty() const { return m_children.empty(); }
+	std::size_t size() const { return m_children.size(); }
+	iterator begin() const { return m_children.begin(); }
+	iterator end()   const { return m_children.end(); }
+	reverse_iterator rbegin() const { return m_children.rbegin(); }
+	reverse_iterator rend()   const { return m_children.rend(); }
+	std::span<Widget* const> children() const { return m_children; }
+
+	Widget* first() const { return empty() ? nullptr : m_children.front(); }
+	Widget* last()  const { return empty() ? nullptr : m_children.back(); }
+	// Neighbors of a child (null past the ends, or if `w` is null)
+	Widget* next(const Widget* w) const { return w && w->m_index + 1 < size() ? m_children[w->m_index + 1] : nullptr; }
+	Widget* prev(const Widget* w) const { return w && w->m_index > 0 ? m_children[w->m_index - 1] : nullptr; }
 
 	// Iterate through the children (i.e. only direct descendants) of the container
 	//!!1. This may need to be defined in Widget instead, because client code
 	//!!   shouldn't really care whether some widgets can or cannot have children.
 	//!!   A homogeneous tree view (in this regard) is preferable.
-	//!!2. As soon as `for (auto i : *this)` gets supported, these should become
-	//!!   just syntactic sugar, directly doing the for loops right here! -> #318
+	//!!2. Now that `for (auto i : *this)` is supported, these are just
+	//!!   syntactic sugar (#318)
 	void foreach  (const std::function<void(Widget*)>& f);
 	void cforeach (const std::function<void(const Widget*)>& f) const;
 	// These can be aborted by f() returning false (making the loop return false, too):
@@ -80,21 +159,138 @@ public:
 
 	// Recursive traversal of all the contained widgets
 	// Does not include this container itself.
+	//
+	// The templated versions are non-virtual, with no type erasure, and
+	// iterate with an explicit stack (instead of recursion), so they cost
+	// little more than a loop. The widgets are visited depth-first, parents
+	// before their children. If `f` returns bool, then returning false from
+	// it skips the subtree of the widget at hand ("pruning").
+	// Notes:
+	// - Only containers are descended into; the virtual overloads (taking
+	//   std::function) remain the entry points for compound widgets that
+	//   manage sub-widgets of their own.
+	// - `f` may add new widgets (they will be visited, too), but must not
+	//   remove any.
+	template <typename F> requires std::invocable<F&, Widget*>
+	void traverse(F&& f);
+	template <typename F> requires std::invocable<F&, const Widget*>
+	void ctraverse(F&& f) const;
+
 	void traverse(const std::function<void(Widget*)>& f) override;
 	void ctraverse(const std::function<void(const Widget*)>&) const override;
 
+	// Layout ------------------------------------------------------------
+	// Adding children or resizing them doesn't rearrange the container right
+	// away, it only marks it for the next layout pass. That runs (once per
+	// frame) before rendering and event processing, but it can also be done
+	// explicitly, e.g. to query the geometry of a container right after
+	// filling it.
+	// Only the containers (and their descendants) marked since the last pass
+	// are visited, children first, so each one is rearranged only once.
+	void updateLayout();
+
 // ---- Internal helpers -----------------------------------------------------
 protected:
 	Widget* insert_after(Widget* anchor, Widget* widget, const std::string& name);
+	// Just the list surgery of insert_after(), without registering & relayout
+	// (A null anchor means inserting as the first child.)
+	void link_after(Widget* anchor, Widget* widget);
+	// Update the indexes of the children from `pos` (after inserting/removing)
+	void reindex_from(size_t pos);
+	// Size up the GUI registry for `count` more widgets (before a batch insert)
+	GUI* reserve_names(size_t count);
+
+	// Check if `widget` is a direct child node (O(1), via its parent pointer)
+	bool is_child(const Widget* widget) const { return widget && widget->m_parent == this; }
 
-	// Check if `widget` is a direct child node
-	bool is_child(const Widget* widget);
+	// Called by detach(), before `child` is unlinked, to let the container
+	// drop any references to it (e.g. as the hovered or focused child)
+	virtual void forget_child(Widget* child) { (void)child; }
+
+	// Mark the container to be rearranged by the next layout pass
+	void invalidateGeometry();
+	bool geometryDirty() const { return m_geometryDirty; }
+	friend class Widget; // for setSize() to call it on the parent
 
 protected:
-	Widget* m_first;
-	Widget* m_last;
+	std::vector<Widget*> m_children; // Each child knows its index here (Widget::m_index)
+
+private:
+	template <class C, class W, typename F>
+	static void traverse_subtree(C* root, F& f);
+
+private:
+	bool m_geometryDirty = true;  // Needs recomputeGeometry()
+	bool m_layoutPending = false; // Some descendant container needs it
 };
 
+
+//----------------------------------------------------------------------------
+namespace internal
+{
+	// Stack for the tree traversals: fixed-size, unless the tree gets deeper
+	// than that, when it spills over to the heap
+	template <typename T, std::size_t N = 32>
+	class SmallStack
+	{
+	public:
+		bool empty() const { return !m_size; }
+		T& top() { return m_size <= N ? m_buffer[m_size - 1] : m_spill.back(); }
+		void push(const T& item)
+		{
+			if (m_size < N) m_buffer[m_size] = item;
+			else m_spill.push_back(item);
+			++m_size;
+		}
+		void pop() { if (m_size-- > N) m_spill.pop_back(); }
+	private:
+		T m_buffer[N];
+		std::vector<T> m_spill;
+		std::size_t m_size = 0;
+	};
+}
+
+template <class C, class W, typename F>
+void WidgetContainer::traverse_subtree(C* root, F& f)
+// C: (const) WidgetContainer, W: (const) Widget
+{
+	struct Level { C* container; std::size_t pos; }; // The next child to visit
+	internal::SmallStack<Level> stack;
+	stack.push({root, 0});
+
+	while (!stack.empty())
+	{
+		auto& [container, pos] = stack.top();
+		if (pos >= container->m_children.size()) // (Indexing, so that `f` can add children)
+		{
+			stack.pop();
+			continue;
+		}
+
+		W* widget = container->m_children[pos++];
+		bool descend = true;
+		if constexpr (std::is_convertible_v<std::invoke_result_t<F&, W*>, bool>)
+			descend = f(widget);
+		else
+			f(widget);
+
+		if (descend && widget->m_isContainer)
+			stack.push({static_cast<C*>(widget), 0});
+	}
+}
+
+template <typename F> requires std::invocable<F&, Widget*>
+void WidgetContainer::traverse(F&& f)
+{
+	traverse_subtree<WidgetContainer, Widget>(this, f);
+}
+
+template <typename F> requires std::invocable<F&, const Widget*>
+void WidgetContainer::ctraverse(F&& f) const
+{
+	traverse_subtree<const WidgetContainer, const Widget>(this, f);
+}
+
 } // namespace
 
 #endif // GUI_WIDGETCONTAINER_HPP
@@ -10,6 +10,10 @@ namespace sfw
 
 /**
  * Widget with a draw "hook" that can be set dynamically at runtime
+ *
+ * NOTE: the GUI can't know when the hook would draw something different,
+ *       so if its output changes (e.g. animates), call invalidate() to make
+ *       GUI::needsRedraw() notice it!
  */
 class DrawHost: public Widget
 {
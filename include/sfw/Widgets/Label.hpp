@@ -3,8 +3,14 @@
 
 #include "sfw/Widget.hpp"
 #include "sfw/Gfx/Elements/Text.hpp"
+#include "sfw/ValueChannel.hpp"
 
 #include <string>
+#include <memory>
+#include <functional>
+#include <optional>
+#include <concepts>
+#include <cstdint>
 
 namespace sfw
 {
@@ -29,16 +35,49 @@ public:
 
     Label* setStyle(sf::Text::Style style);
 
+    // Bind to a value channel, which other threads can then write at any rate,
+    // while the label only samples it at the display rate (see GUI::FRAME_INTERVAL),
+    // and only formats (with `format(value)`) and sets the new text if the
+    // value has changed
+    template <class T, std::invocable<const T&> F>
+    Label* bind(std::shared_ptr<ValueChannel<T>> channel, F format);
+    Label* unbind();
+
 private:
     void draw(const gfx::RenderContext& ctx) const override;
 
     void recomputeGeometry() override;
 
     void onThemeChanged() override;
+    void onTick() override;
+    void start_sampling(); // (Not in the template, to spare including the GUI here)
 
     Text m_text;
+
+    // The bound channel (see bind()), type-erased: returns the new text, if changed
+    std::function<std::optional<std::string>(std::uint64_t& version)> m_sampler;
+    std::uint64_t m_channelVersion = 0;
 };
 
+
+//----------------------------------------------------------------------------
+template <class T, std::invocable<const T&> F>
+Label* Label::bind(std::shared_ptr<ValueChannel<T>> channel, F format)
+{
+    if (!channel)
+        return unbind();
+
+    m_sampler = [channel = std::move(channel), format = std::move(format)](std::uint64_t& version)
+        -> std::optional<std::string>
+    {
+        if (T value{}; channel->load_if_changed(value, version))
+            return std::string(format(value));
+        return std::nullopt;
+    };
+    start_sampling();
+    return this;
+}
+
 } // namespace
 
 #endif // GUI_LABEL_HPP
@@ -0,0 +1,98 @@
+#ifndef _SFW_LISTVIEW_HPP_
+#define _SFW_LISTVIEW_HPP_
+
+#include "sfw/Layout.hpp"
+
+#include <functional>
+#include <vector>
+#include <cstddef> // size_t
+
+namespace sfw
+{
+
+/*****************************************************************************
+   Virtualized list of (any number of) items, with the data supplied by the
+   client via callbacks
+
+   Only as many row widgets are created (by the row factory) as can be seen
+   at a time, and then these are reused while scrolling: the rows coming into
+   view are (re)bound to their new items by the row binder, the rest are just
+   moved. So the list can be arbitrarily long, without the widget tree (and
+   the per-frame costs) growing with it.
+
+   The rows are children of the list, so they get hovered/focused etc. like
+   in any other layout. The list itself scrolls with the mouse wheel, and
+   (if no row has the focus) the Up/Down, PageUp/PageDown, Home/End keys.
+
+   Notes:
+   - All the rows are assumed to be of the same height (the tallest row).
+   - The row binder may change anything in a row, except its parent etc.
+   - After changing the data, call refresh() to update the list.
+ *****************************************************************************/
+class ListView: public Layout
+{
+public:
+	using ItemCount  = std::function<size_t()>;
+	using RowFactory = std::function<Widget*()>; // Create a new (unbound) row widget (with new)
+	using RowBinder  = std::function<void(Widget* row, size_t item)>; // Show `item` in `row`
+
+	ListView(float width, size_t visibleRows, ItemCount count, RowFactory makeRow, RowBinder bindRow);
+
+	// Re-query the item count, and rebind all the visible rows
+	ListView* refresh();
+	size_t itemCount() const { return m_itemCount; }
+
+	// Scrolling
+	ListView* scrollTo(size_t item); // Make `item` the top row (as far as possible)
+	ListView* scroll(long rows);
+	ListView* ensureVisible(size_t item); // Scroll only as much as needed
+	size_t top() const { return m_top; } // The item in the top row
+
+	// The item currently shown by `row` (e.g. for row event callbacks), or
+	// npos if `row` is not a bound row of the list
+	size_t itemAt(const Widget* row) const;
+	static constexpr size_t npos = (size_t)-1;
+
+private:
+	// Helpers
+	// Create the missing rows for the current item count (if any)
+	// Note: not done by the ctor, as the rows would be lost if the list was
+	// then moved (e.g. by WidgetContainer::add(W&&)).
+	bool ensure_rows();
+	// (Re)bind the rows to the items from `top`, reusing the bindings of
+	// the rows that are still in view
+	void bind_rows(size_t top, bool rebind_all = false);
+	void position_rows();
+	void sync_data(); // Re-query the count, and rebind everything
+
+	// Callbacks
+	void recomputeGeometry() override;
+	void draw(const gfx::RenderContext& ctx) const override;
+	void onMouseWheelMoved(int delta) override;
+	void onKeyPressed(const sf::Event::KeyEvent& key) override;
+	void onActivationChanged(ActivationState state) override;
+	void forget_child(Widget* child) override;
+
+	// Config:
+	ItemCount m_count;
+	RowFactory m_makeRow;
+	RowBinder m_bindRow;
+	float m_width;
+	size_t m_visibleRows;
+	// Internal state:
+	size_t m_itemCount = 0;
+	size_t m_top = 0;
+	float m_rowHeight = 0;
+	// The row pool, as a ring: the item `m_top + i` is shown by
+	// m_rows[(m_firstRow + i) % m_rows.size()]
+	std::vector<Widget*> m_rows;
+	size_t m_firstRow = 0;
+	// The focus follows the item, not the row (which gets recycled): it's
+	// dropped while the item is scrolled out, and restored when it's back
+	size_t m_focusedItem = npos;
+	bool m_synced = false; // Data queried (and rows created) at least once
+};
+
+} // namespace
+
+#endif // _SFW_LISTVIEW_HPP_
@@ -152,6 +152,7 @@ template <class T> const std::string& OptionsBox<T>::currentLabel() const
 template <class T> OptionsBox<T>* OptionsBox<T>::setTextColor(const sf::Color& color)
 {
 	m_box.setItemColor(color);
+	this->invalidate();
 	return this;
 }
 
@@ -160,6 +161,7 @@ template <class T> OptionsBox<T>* OptionsBox<T>::setFillColor(const sf::Color& c
 	m_box.setFillColor(color);
 	m_arrowLeft.setTintColor(color);
 	m_arrowRight.setTintColor(color);
+	this->invalidate();
 	return this;
 }
 
@@ -174,6 +176,7 @@ template <class T> auto OptionsBox<T>::update_selection(size_t index)
 		m_currentIndex = index;
 		m_box.item().setString(/*sfw::*/stdstring_to_SFMLString(m_items[index].label));
 		m_box.centerTextHorizontally(m_box.item());
+		this->invalidate();
 	}
 	return this;
 }
@@ -181,6 +184,7 @@ template <class T> auto OptionsBox<T>::update_selection(size_t index)
 
 template <class T> void OptionsBox<T>::update_arrow_pressed_state(ItemBox<Arrow>& arrow, float x, float y)
 {
+	auto oldstate = arrow.activationState();
 	if (arrow.contains(x, y))
 	{
 		if (this->getActivationState() == ActivationState::Pressed) // See comment at the class def., why this->...
@@ -192,6 +196,8 @@ template <class T> void OptionsBox<T>::update_arrow_pressed_state(ItemBox<Arrow>
 	{
 		arrow.applyState(this->focused() ? ActivationState::Focused : ActivationState::Default); // See comment at the class def., why this->...
 	}
+	if (arrow.activationState() != oldstate)
+		this->invalidate();
 }
 
 
@@ -199,9 +205,9 @@ template <class T> void OptionsBox<T>::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= this->getTransform(); // See comment at the class def., why this->...
-	ctx.target.draw(m_box, sfml_renderstates);
-	ctx.target.draw(m_arrowLeft, sfml_renderstates);
-	ctx.target.draw(m_arrowRight, sfml_renderstates);
+	ctx.draw(m_box, sfml_renderstates);
+	ctx.draw(m_arrowLeft, sfml_renderstates);
+	ctx.draw(m_arrowRight, sfml_renderstates);
 }
 
 
@@ -287,6 +293,9 @@ template <class T> void OptionsBox<T>::onMouseReleased(float x, float y)
 
 template <class T> void OptionsBox<T>::onMouseWheelMoved(int delta)
 {
+	// Only while focused, so it doesn't hijack the scrolling of the page
+	if (!this->focused()) return this->decline_wheel();
+
 	if (delta < 0) selectNext(); else selectPrevious();
 }
 
@@ -5,6 +5,10 @@
 #include "sfw/Geometry.hpp"
 #include "sfw/Gfx/Elements/Box.hpp"
 #include "sfw/Gfx/Elements/Text.hpp"
+#include "sfw/ValueChannel.hpp"
+
+#include <memory>
+#include <cstdint>
 
 namespace sfw
 {
@@ -69,10 +73,16 @@ public:
 	float min() const;
 	float max() const;
 
+	// Bind to a value channel, which other threads can then write at any rate,
+	// while the bar only samples it at the display rate (see GUI::FRAME_INTERVAL),
+	// updating itself only if the value has changed; null unbinds it
+	ProgressBar* bind(std::shared_ptr<ValueChannel<float>> channel);
+
 private:
 	void draw(const gfx::RenderContext& ctx) const override;
 	// Callbacks
 	void onThemeChanged() override;
+	void onTick() override;
 	// Helpers
 	void updateGeometry();
 	float track_length() const;
@@ -83,6 +93,8 @@ private:
 	Cfg m_cfg;
 
 	float m_value;
+	std::shared_ptr<ValueChannel<float>> m_channel; // See bind()
+	std::uint64_t m_channelVersion = 0;
 
 	Box m_box;
 	sf::Vertex m_bar[_VERTEX_COUNT_];
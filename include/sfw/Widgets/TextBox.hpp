@@ -5,6 +5,7 @@
 #include "sfw/Gfx/Elements/Text.hpp"
 #include "sfw/Gfx/Elements/Box.hpp"
 #include "sfw/TextSelection.hpp"
+#include "sfw/TimerWheel.hpp"
 
 #include <string>
 
@@ -106,6 +107,10 @@ private:
 	void onTextEntered(char32_t unichar) override;
 	void onActivationChanged(ActivationState state) override;
 	void onThemeChanged() override;
+	void onTick() override;
+
+	// Schedule the next visible change of the cursor (or cancel it, if not focused)
+	void schedule_blink();
 
 	// Config:
 	size_t        m_maxLength;
@@ -134,6 +139,7 @@ private:
 	mutable sf::RectangleShape m_cursorRect;
 	mutable sf::Color m_cursorColor;
 	mutable sf::Clock m_cursorTimer;
+	TimerWheel::Id m_blinkTimer; // Only pending while focused
 };
 
 } // namespace
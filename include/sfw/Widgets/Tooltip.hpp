@@ -10,6 +10,7 @@
 #include <SFML/Graphics/Color.hpp>
 
 #include <string>
+#include <optional>
 
 namespace sfw {
 
@@ -28,9 +29,10 @@ public:
 	Tooltip(Widget* owner, std::string text);
 	Tooltip(const Tooltip&) = delete;
 	Tooltip(Tooltip&&) = delete;
+	~Tooltip() override;
 
 	void setText(const std::string& text);
-	std::string getText() const { return m_text.get(); }
+	std::string getText() const { return m_content; }
 
 	void setState(State s);
 
@@ -50,10 +52,15 @@ public:
 	void dismiss();
 		// Fadeout if already visible
 
+	void cancel();
+		// Turn off immediately, and drop out of the GUI's active list, too
+		// (e.g. before the owner gets detached from the GUI)
+
 // ---- Queries --------------------------------------------------------------
 	bool visible() const;
 	bool armed() const;
 	bool elapsed(float time_interval);
+	float nextChange() const; // Session time of the next state change (or animation step), if armed
 
 // ---- Callbacks ------------------------------------------------------------
 	void draw(const gfx::RenderContext& ctx) const override;
@@ -62,6 +69,7 @@ public:
 // ---- Internal helpers -----------------------------------------------------
 private:
 	void initView();
+	void set_opacity(float opacity); // 0..1 (for fading out)
 
 // ---- Data -----------------------------------------------------------------
 private:
@@ -70,10 +78,15 @@ private:
 	Widget* m_owner; GUI* getMain() const { return m_owner ? m_owner->getMain() : nullptr; }
 
 	State m_state{Off};
+	std::string m_content;
 	FilledRect m_box;
-	Text m_text;
+	std::optional<Text> m_text; // Only created when first armed (most tooltips would never be shown)
 	size_t m_length; // of the text (cached to spare the length queries)
 	float m_timeStateChange;
+	float m_lastFadeStep = 0; // Session time of the last Fadeout step
+	GUI* m_gui = nullptr; // Set while listed as active by the GUI
+
+friend class GUI;
 };
 
 } // namespace
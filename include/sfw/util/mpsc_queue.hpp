@@ -0,0 +1,108 @@
+#ifndef SFW_MPSC_QUEUE_HPP
+#define SFW_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <optional>
+#include <utility> // move
+#include <cstddef> // size_t
+
+namespace sfw::util
+{
+
+//----------------------------------------------------------------------------
+// Unbounded, lock-free multi-producer, single-consumer queue
+//
+// (Vyukov's intrusive MPSC queue.) Pushing is a single atomic exchange (plus
+// allocating the node), from any number of threads; popping is wait-free,
+// but must only ever be done by one (the same) thread.
+//
+// A pop may briefly see the queue as empty while a push is half-way done
+// (i.e. the item will only be found by a later pop), which is fine for
+// periodically drained command queues like the one in the GUI.
+//
+// The destructor discards the items still queued; nothing must be pushed
+// after (or while) it's destroyed.
+//
+template <class T>
+class MPSCQueue
+{
+public:
+	MPSCQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+	MPSCQueue(const MPSCQueue&) = delete;
+	~MPSCQueue() { while (pop()) {} }
+
+	// Any thread
+	void push(T value)
+	{
+		push_link(new Node(std::move(value)));
+	}
+
+	// Consumer thread only
+	std::optional<T> pop()
+	{
+		Link* tail = m_tail;
+		Link* next = tail->next.load(std::memory_order_acquire);
+
+		if (tail == &m_stub) // Skip the stub
+		{
+			if (!next) return std::nullopt;
+			m_tail = tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		if (!next)
+		{
+			// The last item: can only be taken if no push is half-way done,
+			// and then the stub has to be put back first, to keep the chain
+			if (tail != m_head.load(std::memory_order_acquire))
+				return std::nullopt;
+			push_link(&m_stub);
+			next = tail->next.load(std::memory_order_acquire);
+			if (!next) return std::nullopt;
+		}
+
+		m_tail = next;
+		auto* node = static_cast<Node*>(tail);
+		std::optional<T> value{std::move(node->value)};
+		delete node;
+		return value;
+	}
+
+	// Consumer thread only: call f(T&&) for each item available, and return their number
+	template <class F>
+	std::size_t drain(F&& f)
+	{
+		std::size_t n = 0;
+		while (auto value = pop()) { f(std::move(*value)); ++n; }
+		return n;
+	}
+
+	// Consumer thread only (may miss items being pushed right now)
+	bool empty() const
+	{
+		return m_tail == &m_stub && !m_stub.next.load(std::memory_order_acquire);
+	}
+
+private:
+	struct Link { std::atomic<Link*> next{nullptr}; };
+	struct Node : Link
+	{
+		T value;
+		explicit Node(T&& v) : value(std::move(v)) {}
+	};
+
+	void push_link(Link* link)
+	{
+		link->next.store(nullptr, std::memory_order_relaxed);
+		Link* prev = m_head.exchange(link, std::memory_order_acq_rel);
+		prev->next.store(link, std::memory_order_release);
+	}
+
+	Link m_stub;
+	std::atomic<Link*> m_head; // The most recently pushed (producers)
+	Link* m_tail;              // The next to pop (consumer)
+};
+
+} // namespace sfw::util
+
+#endif // SFW_MPSC_QUEUE_HPP
@@ -0,0 +1,85 @@
+#ifndef SFW_POOL_HPP
+#define SFW_POOL_HPP
+
+#include <vector>
+#include <new>
+#include <cstddef> // size_t
+
+namespace sfw::util
+{
+
+//----------------------------------------------------------------------------
+// Size-class pool for small objects (like widgets)
+//
+// Blocks are carved out of large slabs, with a separate slab (and free list)
+// for each size class, so objects of the same size (typically of the same
+// type) end up next to each other in memory, and freeing them is just
+// pushing them onto a free list, for reuse.
+// Requests larger than MAX_SIZE are passed on to the global allocator.
+//
+// The slabs are only released by the destructor.
+//
+// Note: not thread-safe (like the rest of the GUI)!
+//
+class SizeClassPool
+{
+public:
+	static constexpr std::size_t GRANULARITY = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	static constexpr std::size_t MAX_SIZE    = 1024;
+	static constexpr std::size_t SLAB_SIZE   = 64 * 1024;
+
+	SizeClassPool() = default;
+	SizeClassPool(const SizeClassPool&) = delete;
+	~SizeClassPool() { for (void* slab : m_slabs) ::operator delete(slab); }
+
+	void* allocate(std::size_t size)
+	{
+		if (size > MAX_SIZE) return ::operator new(size);
+
+		auto& cls = m_classes[class_of(size)];
+		if (cls.free)
+		{
+			auto* block = cls.free;
+			cls.free = block->next;
+			return block;
+		}
+
+		auto block_size = (class_of(size) + 1) * GRANULARITY;
+		if (cls.cursor + block_size > cls.end)
+		{
+			m_slabs.push_back(::operator new(SLAB_SIZE));
+			cls.cursor = (char*)m_slabs.back();
+			cls.end = cls.cursor + SLAB_SIZE;
+		}
+		void* p = cls.cursor;
+		cls.cursor += block_size;
+		return p;
+	}
+
+	// `size` must be the same as for allocate()
+	void deallocate(void* p, std::size_t size) noexcept
+	{
+		if (!p) return;
+		if (size > MAX_SIZE) { ::operator delete(p); return; }
+
+		auto& cls = m_classes[class_of(size)];
+		cls.free = new (p) FreeBlock{cls.free};
+	}
+
+private:
+	static constexpr std::size_t class_of(std::size_t size) { return size ? (size - 1) / GRANULARITY : 0; }
+
+	struct FreeBlock { FreeBlock* next; };
+	struct SizeClass
+	{
+		FreeBlock* free = nullptr;
+		char* cursor = nullptr; // Next unused block in the current slab of the class
+		char* end = nullptr;
+	};
+	SizeClass m_classes[MAX_SIZE / GRANULARITY];
+	std::vector<void*> m_slabs;
+};
+
+} // namespace sfw::util
+
+#endif // SFW_POOL_HPP
@@ -5,13 +5,15 @@
 #include <string> // to_string
 #include <iostream> // cerr, for errors, cout for some "demo" info
 #include <thread>
+#include <atomic>
 #include <chrono>
 #include <cassert>
 using namespace std;
 
-void background_thread_main(sfw::GUI& gui);
+void background_thread_main(sfw::GUI& gui, sfw::WidgetHandle<sfw::Slider> rot_slider);
 
-static auto toy_anim_on = false;
+static std::atomic<bool> toy_anim_on = false; // Also read by the bg. thread
+static std::atomic<bool> bg_thread_quit = false;
 
 int main()
 {
@@ -467,7 +469,9 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 
 	//--------------------------------------------------------------------
 	// Start another thread for the fun of it
-	thread bg_thread(background_thread_main, std::ref(demo));
+	// (The handle must be taken here, on the GUI thread.)
+	thread bg_thread(background_thread_main, std::ref(demo),
+		sfw::WidgetHandle<sfw::Slider>(sfw::getWidget<sfw::Slider>("rotation-slider", demo)));
 
 	//--------------------------------------------------------------------
 	// Start the event loop
@@ -490,7 +494,8 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 	}
 
 	//--------------------------------------------------------------------
-	// Finish the bg. thread, too
+	// Finish the bg. thread, too (before the GUI is gone!)
+	bg_thread_quit = true;
 	bg_thread.join();
 
 	return EXIT_SUCCESS;
@@ -498,27 +503,24 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 
 
 //----------------------------------------------------------------------------
-void background_thread_main(sfw::GUI& gui)
+void background_thread_main(sfw::GUI& gui, sfw::WidgetHandle<sfw::Slider> rot_slider)
 {
-	auto rot_slider = sfw::getWidget<sfw::Slider>("rotation-slider", gui);
-	if (!rot_slider)
-		return;
-
-	while (gui)
+	// The GUI (and the widgets) must only be used by the GUI thread, so
+	// this thread just posts the changes for it to run (see GUI::post())
+	while (!bg_thread_quit)
 	{
 		// Cycle the rot. slider
-	        auto sampletext_angle = sf::degrees(rot_slider->get());
-		rot_slider->update(int(sampletext_angle.asDegrees()) % 360 + 2);
+		gui.post(rot_slider, [](sfw::Slider* slider) {
+			auto sampletext_angle = sf::degrees(slider->get());
+			slider->update(int(sampletext_angle.asDegrees()) % 360 + 2);
+		});
 
 		do this_thread::sleep_for(chrono::milliseconds(50));
 		// Keep on sleeping while the anim. is disabled, and poll for termination:
-		while (!toy_anim_on && gui);
-		// (NOTE: doing this AFTER manipulating the widget, because the GUI
-		// may have been shut down in the meantime, and it's unhealthy (UB)
-		// to still keep using it then...
-		// This is far from bullet-proof, of course, as the threads aren't
-		// synced in any way, but for a demo like this, it's OK.)
-
-		cerr << gui.sessionTime() << "           \b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b";
+		while (!toy_anim_on && !bg_thread_quit);
+
+		gui.post([&gui] {
+			cerr << gui.sessionTime() << "           \b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b";
+		});
 	}
 }
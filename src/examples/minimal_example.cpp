@@ -23,21 +23,18 @@ int main()
     gui.add(sfw::Button("Close!", [&] { gui.close(); }));
 
     // Event loop (blocking variant)
-    while (gui) // Or while(gui.active()), but we're in a minimal example. ;)
+    // Sleep until the next events come (or something time-based, like a
+    // tooltip, needs updating), then pass them all to the GUI, until closing
+    // or an error has occured
+    while (gui.waitAndProcess(window, [&](const sf::Event&) { /* Your own custom event processing here... */ }))
     {
-        // Render the GUI
-        gui.render();
-
-        // Actually show the (updated) window content
-        window.display();
-
-        // Process events, one by one, waiting until the next one comes
-        if (sf::Event event; window.waitEvent(event))
+        // Render the GUI, if anything has changed
+        if (gui.needsRedraw())
         {
-            // Pass events to the GUI
-            gui.process(event);
+            gui.render();
 
-            // Your own custom event processing here...
+            // Actually show the (updated) window content
+            window.display();
         }
     }
 
@@ -5,9 +5,11 @@
 
 //!! Stuff for clearing the bg. when not owning the entire window
 //!! (Should be moved to the Renderer!)
-#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/Color.hpp>
 
+#include <SFML/System/Sleep.hpp>
+
 #include <charconv>
 #include <system_error>
 #include <iostream> // for printing errors/warnings
@@ -31,17 +33,33 @@ GUI::GUI(sf::RenderWindow& window, const sfw::Theme::Cfg& themeCfg, bool own_the
 	setParent(this);
 
 	// Also register ourselves to our own widget registry:
-	widgets["/"] = this;
+	remember(this, "/");
 
 	// Add as the "most recent" GUI manager:
 	if (GUI::DefaultInstance) {
 		cerr << "- Note: overriding previous default GUI instance (" << DefaultInstance << " with newly created " << this << ")\n";
 	}
 	GUI::DefaultInstance = this;
+	++internal::name_registry_generation; // Cached lookups may have been done via the previous one
 
 	reset();
 }
 
+GUI::~GUI()
+{
+	delete_removed(); // (Just in case we're being destroyed by an event handler...)
+
+	// The tooltips would only be deleted (with their owners) after we're gone,
+	// so they must not try to unlist themselves then:
+	for (auto* tooltip : m_activeTooltips)
+		tooltip->m_gui = nullptr;
+
+	// Don't leave cached name lookups pointing into a dead GUI:
+	if (GUI::DefaultInstance == this)
+		GUI::DefaultInstance = nullptr;
+	++internal::name_registry_generation;
+}
+
 
 //----------------------------------------------------------------------------
 bool GUI::active()
@@ -99,9 +117,27 @@ bool GUI::closed()
 
 //----------------------------------------------------------------------------
 bool GUI::process(const sf::Event& event)
+{
+	// Widgets removed by the event handlers are only deleted after the whole
+	// dispatch (see WidgetContainer::remove()), as they may be removing
+	// themselves, or the containers that are still dispatching to them
+	++m_dispatching;
+	bool ok = dispatch_event(event);
+	if (--m_dispatching == 0)
+		delete_removed();
+	return ok;
+}
+
+bool GUI::dispatch_event(const sf::Event& event)
 {
 	thread_local bool event_processing_started = false;
 
+	// Catch up with the other threads first
+	run_posted();
+
+	// Hit-testing etc. needs the geometry to be up-to-date
+	updateLayout();
+
 	if (!event_processing_started)
 	{
 		//!!Call the subscription-based onEventProcessingStarted() notifications!...
@@ -123,11 +159,16 @@ bool GUI::process(const sf::Event& event)
 		break;
 	}
 
+	//! Mouse clicks and keyboard input tend to change all sorts of internal
+	//! widget state (like text cursor positions, arrow button states etc.),
+	//! and are rare enough to not bother tracking it more precisely, so just
+	//! redraw after these:
 	case sf::Event::MouseButtonPressed:
 		if (event.mouseButton.button == sf::Mouse::Button::Left)
 		{
 			sf::Vector2f mouse = convertMousePosition(event.mouseButton.x, event.mouseButton.y);
 			onMousePressed(mouse.x, mouse.y);
+			invalidate();
 		}
 		break;
 
@@ -136,23 +177,33 @@ bool GUI::process(const sf::Event& event)
 		{
 			sf::Vector2f mouse = convertMousePosition(event.mouseButton.x, event.mouseButton.y);
 			onMouseReleased(mouse.x, mouse.y);
+			invalidate();
 		}
 		break;
 
 	case sf::Event::MouseWheelScrolled:
 		onMouseWheelMoved((int)event.mouseWheelScroll.delta);
+		invalidate();
 		break;
 
 	case sf::Event::KeyPressed:
 		onKeyPressed(event.key);
+		invalidate();
 		break;
 
 	case sf::Event::KeyReleased:
 		onKeyReleased(event.key);
+		invalidate();
 		break;
 
 	case sf::Event::TextEntered:
 		onTextEntered(event.text.unicode);
+		invalidate();
+		break;
+
+	case sf::Event::Resized:
+	case sf::Event::GainedFocus:
+		invalidate();
 		break;
 
 	case sf::Event::Closed:
@@ -168,6 +219,59 @@ bool GUI::process(const sf::Event& event)
 }
 
 
+bool GUI::process(std::span<const sf::Event> events)
+{
+	for (size_t i = 0; i < events.size(); ++i)
+	{
+		const auto& event = events[i];
+		auto next_is = [&](sf::Event::EventType type) {
+			return i + 1 < events.size() && events[i + 1].type == type; };
+
+		if (event.type == sf::Event::MouseMoved)
+		{
+			// Only the last of a run of moves matters
+			if (next_is(sf::Event::MouseMoved))
+				continue;
+		}
+		else if (event.type == sf::Event::MouseWheelScrolled)
+		{
+			// Sum up a run of scrolls (with the position of the last one)
+			if (next_is(sf::Event::MouseWheelScrolled)
+			    && events[i + 1].mouseWheelScroll.wheel == event.mouseWheelScroll.wheel)
+			{
+				sf::Event merged = event;
+				while (next_is(sf::Event::MouseWheelScrolled)
+				       && events[i + 1].mouseWheelScroll.wheel == event.mouseWheelScroll.wheel)
+				{
+					const auto& scroll = events[++i].mouseWheelScroll;
+					merged.mouseWheelScroll.delta += scroll.delta;
+					merged.mouseWheelScroll.x = scroll.x;
+					merged.mouseWheelScroll.y = scroll.y;
+				}
+				if (!process(merged)) return false;
+				continue;
+			}
+		}
+
+		if (!process(event)) return false;
+	}
+
+	return active();
+}
+
+
+void GUI::delete_removed()
+{
+	// (Deleting may remove even more, so not a range-for)
+	while (!m_removedWidgets.empty())
+	{
+		auto* widget = m_removedWidgets.back();
+		m_removedWidgets.pop_back();
+		delete widget;
+	}
+}
+
+
 //----------------------------------------------------------------------------
 bool GUI::setTheme(const sfw::Theme::Cfg& themeCfg)
 {
@@ -198,6 +302,8 @@ void GUI::themeChanged()
 {
 	// Notify widgets of the change...
 
+	invalidate();
+
 	// Start with the GUI itself
 	onThemeChanged();
 
@@ -212,9 +318,10 @@ void GUI::themeChanged()
 	//! This would be redundant in the current model:
 	//!traverse([](Widget* w) { w->recomputeGeometry(); } );
 	//! The onThemeChanged() call typically involves setSize() too, which
-	//! in turn also calls parent->recomputeGeometry() (via Widget::setSize)!
-	//! (NOTE: there are ample chances of infinite looping here too, some of
-	//! which I've duly explored already...)
+	//! in turn also marks the parent for relayout (via Widget::setSize), and
+	//! then the next layout pass rearranges every affected container once.
+	//! (NOTE: there used to be ample chances of infinite looping here, when
+	//! that relayout was still done immediately...)
 }
 
 
@@ -230,12 +337,18 @@ void GUI::renderBackground() //!!Move this to the renderer!
 		else
 		{
 			// Just clear the GUI rect
-			sf::RectangleShape bgRect(getSize());
-			bgRect.setPosition(getPosition());
-			bgRect.setFillColor(Theme::bgColor);
-			bgRect.setOutlineThickness(0);
-			//!!renderer.draw(bgRect);...
-			m_window.draw(bgRect);
+			// (Theme::bgColor may have been changed directly by the app, so
+			// that's checked here, too, not just the geometry.)
+			auto [x0, y0] = getPosition();
+			auto [x1, y1] = getPosition() + getSize();
+			if (m_bgRect[0].position != sf::Vector2f{x0, y0} || m_bgRect[3].position != sf::Vector2f{x1, y1}
+			    || m_bgRect[0].color != Theme::bgColor)
+			{
+				m_bgRect[0] = {{x0, y0}, Theme::bgColor}; m_bgRect[1] = {{x0, y1}, Theme::bgColor};
+				m_bgRect[2] = {{x1, y0}, Theme::bgColor}; m_bgRect[3] = {{x1, y1}, Theme::bgColor};
+			}
+			//!!renderer.draw(m_bgRect);...
+			m_window.draw(m_bgRect, 4, sf::PrimitiveType::TriangleStrip);
 		}
 	}
 
@@ -249,17 +362,144 @@ void GUI::renderBackground() //!!Move this to the renderer!
 }
 
 //----------------------------------------------------------------------------
-void GUI::render()
+bool GUI::needsRedraw()
+{
+	if (!active()) return false;
+
+	if (!m_ticked)
+	{
+		onTick(); // May also invalidate stuff
+		m_ticked = true;
+	}
+	updateLayout(); // (Would invalidate whatever it moves or resizes.)
+
+	// No frame will be rendered for this tick, so the next call must tick
+	// again (or idle loops would never advance animations, timers etc.):
+	if (!dirty())
+	{
+		m_ticked = false;
+		return false;
+	}
+	return true;
+}
+
+
+//----------------------------------------------------------------------------
+std::optional<float> GUI::nextDeadline()
+{
+	if (!active()) return std::nullopt;
+
+	updateLayout();
+	if (dirty() || !m_commands.empty())
+		return 0.f;
+
+	std::optional<float> result;
+	auto consider = [&result](float t) { result = result ? min(*result, t) : t; };
+
+	// Widgets animating on every tick only need one per frame (not a busy loop)
+	if (Widget::ticks_requested(this))
+		consider(max(0.f, FRAME_INTERVAL - m_clock.getElapsedTime().asSeconds()));
+
+	auto now_ticks = timer_now();
+	if (auto due = m_timers.nextDue(); due)
+		consider(*due > now_ticks ? float(*due - now_ticks) / 1000 : 0.f);
+
+	// Tooltips are not on timers (but only the armed ones are listed anyway)
+	auto now = sessionTime() + m_clock.getElapsedTime().asSeconds();
+	for (const auto* tooltip : m_activeTooltips)
+		if (tooltip->armed()) consider(max(0.f, tooltip->nextChange() - now));
+
+	return result;
+}
+
+
+bool GUI::waitAndProcess(sf::Window& window, const std::function<void(const sf::Event&)>& handler)
+{
+	if (!active()) return false;
+
+	m_eventBatch.clear();
+	sf::Event event;
+	sf::Clock waited;
+	auto deadline = nextDeadline();
+	// Keep polling for posted commands while the other threads are active
+	bool posting = m_postsPending.load(std::memory_order_relaxed) > 0;
+	if (auto last_post = m_lastPostTime.load(std::memory_order_relaxed); !posting && last_post)
+		posting = std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(last_post)
+		          < std::chrono::duration<float>(POST_IDLE_TIMEOUT);
+
+	if (!deadline && !posting)
+	{
+		// Nothing to wake up for but input
+		if (window.waitEvent(event))
+			m_eventBatch.push_back(event);
+	}
+	else if (!deadline || *deadline > 0)
+	{
+		// SFML can't wait for events with a timeout (and posted commands couldn't
+		// interrupt the wait anyway), so just nap between polls
+		for (;;)
+		{
+			if (window.pollEvent(event))
+			{
+				m_eventBatch.push_back(event);
+				break;
+			}
+			if (!m_commands.empty()) break;
+
+			// (Without a deadline, just nap once, to recheck the posting activity)
+			auto left = (deadline ? *deadline : INPUT_POLL_INTERVAL) - waited.getElapsedTime().asSeconds();
+			if (left <= 0) break;
+			sf::sleep(sf::seconds(min(left, INPUT_POLL_INTERVAL)));
+		}
+	}
+
+	// Collect the rest of the burst, too
+	while (window.pollEvent(event))
+		m_eventBatch.push_back(event);
+
+	run_posted(); // (In case there were no events to do it)
+
+	// Whatever we've been waiting for is due now, so tick for it right away
+	// (rather than leaving it to the next needsRedraw() or render(), which
+	// the app may not even call, if it has nothing else to do)
+	if (deadline && waited.getElapsedTime().asSeconds() >= *deadline && !m_ticked)
+	{
+		onTick();
+		m_ticked = true;
+	}
+
+	bool ok = process(m_eventBatch);
+	if (handler)
+		for (const auto& e : m_eventBatch) handler(e);
+
+	return ok;
+}
+
+
+//----------------------------------------------------------------------------
+bool GUI::render()
 {
-	if (!active()) return;
+	if (!active()) return false;
 
 	// Hitchhike the per-frame draw routine for updating the session time...
-	onTick();
+	// (Unless needsRedraw() has already done it for this frame.)
+	if (!m_ticked) onTick();
+	m_ticked = false;
+
+	// Run the (deferred) layout pass, if anything has changed
+	updateLayout();
 
 	/*m_renderer.*/renderBackground();
 
 	// Draw whatever we have, via our a top-level widget container ancestor
-	/*m_renderer.*/draw(gfx::RenderContext{m_window, sf::RenderStates()}); //! function-style RenderContext(...) failed with CLANG
+	// (Widgets only queue their stuff to the renderer, which then draws it
+	// all in a few batches.)
+	m_renderer.begin(m_window);
+	draw(gfx::RenderContext{m_window, sf::RenderStates(), &m_renderer}); //! function-style RenderContext(...) failed with CLANG
+	m_renderer.flush();
+
+	m_dirty = false; // (The children have been cleared by Layout::draw().)
+	return true;
 }
 
 
@@ -275,39 +515,37 @@ void GUI::draw(const gfx::RenderContext& ctx) const
 	//!!draw() calls do not exist here, with this flat widget iteration, so we have to
 	//!!replicate that using that Transform() hack below... :-/ (See also: #315)
 	//!!
+	//! Only the active tooltips are iterated here, not the whole tree.
 	auto widget_ctx = ctx;
-	ctraverse([&widget_ctx](const Widget* w) {
-		if (w->m_tooltip) {
-			auto widget_pos = w->getParent()->getAbsolutePosition();
-			//!!SFML-specific:
-			widget_ctx.props.transform = sf::Transform(
-				1, 0, widget_pos.x,
-				0, 1, widget_pos.y,
-				0, 0, 1);
-
-			w->m_tooltip->draw(widget_ctx);
-		}
-	});
+	for (const auto* tooltip : m_activeTooltips)
+	{
+		if (!tooltip->visible())
+			continue;
+
+		auto widget_pos = tooltip->m_owner->getParent()->getAbsolutePosition();
+		//!!SFML-specific:
+		widget_ctx.props.transform = sf::Transform(
+			1, 0, widget_pos.x,
+			0, 1, widget_pos.y,
+			0, 0, 1);
+
+		tooltip->draw(widget_ctx);
+	}
 }
 
 
 //----------------------------------------------------------------------------
-bool GUI::remember(Widget* widget, string name, bool override_existing)
+bool GUI::remember(Widget* widget, const string& name, bool override_existing)
 {
+	++internal::name_registry_generation; // (Even on failure; it's cheap, and can't go stale this way.)
+
 	if (name.empty())
 	{
-		// Make the default name hex, for a more climactic debug experience...:
-		char defname[17] = {0}; to_chars(defname, std::end(defname), (size_t)(void*)widget, 16);
-		name = string(defname);
-		// Paranoid sanity-checking of this default name
-		if (widgets[name] != nullptr)
-		{
-			cerr << "- Warning: Widget ["<<name<<"] has already been registered with this default name.\n";
-			assert(widgets[name] == widget);
-			return true;
-		}
+		// The default name is implicit, nothing to do
+		return true;
 	}
-	else if (auto other_it = widgets.find(name); other_it != widgets.end()) // Someone has this name aleady?
+
+	if (auto other_it = widgets.find(name); other_it != widgets.end()) // Someone has this name aleady?
 	{
 		Widget* other = other_it->second;
 		if (other == widget)
@@ -326,36 +564,76 @@ bool GUI::remember(Widget* widget, string name, bool override_existing)
 			cerr << "- Warning: Another widget has already been registered as \"" << name << "\".\n"
 			     << "  Overriding...\n";
 
-			// Forget the name of the other widget:
-			[[maybe_unused]] auto result_of_forgetting = remember(other, "");
-			assert(result_of_forgetting);
+			// Forget this name of the other widget:
+			forget(other, name);
 
 			// Fall through to assign `name` to `widget`...
 		}
 	}
-	
-	widgets[name] = widget;
+
+	widgets.emplace(name, widget);
+	m_widgetNames[widget].push_back(name);
 	return true;
 }
 
+void GUI::forget(const Widget* widget)
+{
+	if (auto it = m_widgetNames.find(widget); it != m_widgetNames.end())
+	{
+		for (const auto& name : it->second)
+			widgets.erase(name);
+		m_widgetNames.erase(it);
+		++internal::name_registry_generation;
+	}
+}
+
+void GUI::forget(const Widget* widget, const std::string& name)
+{
+	if (auto it = m_widgetNames.find(widget); it != m_widgetNames.end())
+	{
+		widgets.erase(name);
+		std::erase(it->second, name);
+		if (it->second.empty()) m_widgetNames.erase(it);
+		++internal::name_registry_generation;
+	}
+}
+
 //----------------------------------------------------------------------------
 Widget* GUI::recall(std::string_view name) const
 {
-	string name__cpp_double_bullshit{name}; // a) Can't just map.find(string_viuw), b) can't just string = string_view
-
-	auto widget_iter = widgets.find(name__cpp_double_bullshit);
-	if (widget_iter == widgets.end()) cerr << "- Warning: widget \"" << name__cpp_double_bullshit << "\" not found!\n";
-//if (widget_iter != widgets.end()) cerr << "recall: found widget: \"" << widget_iter->first << "\" == "<< (void*)widget_iter->second <<"\n";
-	return widget_iter != widgets.end() ? widget_iter->second : (Widget*)nullptr;
+	return recall(internal::HashedName{name, internal::name_hash(name)});
 }
 
-string GUI::recall(const Widget* w) const
+Widget* GUI::recall(const internal::HashedName& key) const
 {
-	for (const auto& [name, widget]: widgets)
+	if (auto widget_iter = widgets.find(key); widget_iter != widgets.end())
+		return widget_iter->second;
+
+	std::string_view name = key.name;
+
+	// Not a registered name, but could still be a default one (i.e. the hex
+	// address of an unnamed widget), so try finding it the hard way...
+	size_t addr = 0;
+	if (auto [end, err] = from_chars(name.data(), name.data() + name.size(), addr, 16);
+	    err == std::errc() && end == name.data() + name.size())
 	{
-		if (widget == w) return name;
+		Widget* found = nullptr;
+		const_cast<GUI*>(this)->traverse([&](Widget* w) { if ((size_t)(void*)w == addr) found = w; });
+		if (found) return found;
 	}
-	return "";
+
+	cerr << "- Warning: widget \"" << name << "\" not found!\n";
+	return nullptr;
+}
+
+string GUI::recall(const Widget* w) const
+{
+	if (auto it = m_widgetNames.find(w); it != m_widgetNames.end())
+		return it->second.back(); // (Never empty)
+
+	// Default name: hex, for a more climactic debug experience...
+	char defname[17] = {0}; to_chars(defname, std::end(defname), (size_t)(void*)w, 16);
+	return string(defname);
 }
 
 
@@ -418,6 +696,7 @@ void GUI::setWallpaper(std::string filename, Wallpaper::Placement placement, sf:
 	m_wallpaper.setSize(getSize()); //!!Rename it to `setWallSize` or sg. more expressive!
 	m_wallpaper.setColor(tint);
 	m_wallpaper.enable();
+	invalidate();
 
 	//!! This shoud be done by the wallpaper itself!
 	//!!using Wallpaper::Placement;
@@ -432,6 +711,7 @@ void GUI::setWallpaper(std::string filename, Wallpaper::Placement placement, sf:
 void GUI::setWallpaperColor(sf::Color tint)
 {
 	m_wallpaper.setColor(tint);
+	invalidate();
 }
 
 bool GUI::hasWallpaper()
@@ -446,6 +726,7 @@ bool GUI::hasWallpaper()
 void GUI::disableWallpaper()
 {
 	m_wallpaper.disable();
+	invalidate();
 	assert(!m_wallpaper);
 }
 
@@ -474,6 +755,79 @@ float GUI::sessionTime() const
 }
 
 
+//----------------------------------------------------------------------------
+// Timers...
+//----------------------------------------------------------------------------
+
+TimerWheel::Tick GUI::timer_now() const
+{
+	// Not just m_sessionTime: that's only updated once per frame
+	auto us = (m_sessionTime + m_clock.getElapsedTime()).asMicroseconds();
+	return us > 0 ? TimerWheel::Tick(us / 1000) : 0;
+}
+
+
+namespace {
+	TimerWheel::Tick to_ticks(float seconds) { return seconds > 0 ? TimerWheel::Tick(seconds * 1000 + 0.999f) : 0; }
+}
+
+GUI::TimerId GUI::startTimer(float delay, std::function<void()> callback, float period, const Widget* owner)
+{
+	return start_timer(timer_now() + to_ticks(delay), std::move(callback), period, owner);
+}
+
+GUI::TimerId GUI::startTimerAt(float sessiontime, std::function<void()> callback, float period, const Widget* owner)
+{
+	return start_timer(to_ticks(sessiontime), std::move(callback), period, owner);
+}
+
+GUI::TimerId GUI::start_timer(TimerWheel::Tick due, std::function<void()> callback, float period, const Widget* owner)
+{
+	return m_timers.start(due, to_ticks(period),
+		[this, owner = WidgetHandle<>(owner), bound = owner != nullptr, callback = std::move(callback)]
+		{
+			if (bound)
+			{
+				auto* w = owner.get();
+				if (!w || w->getMain() != this) return false; // Gone (removed or deleted)
+			}
+			callback();
+			return true;
+		});
+}
+
+bool GUI::stopTimer(TimerId id)
+{
+	return m_timers.stop(id);
+}
+
+bool GUI::timerPending(TimerId id) const
+{
+	return m_timers.pending(id);
+}
+
+
+//----------------------------------------------------------------------------
+// Cross-thread commands...
+//----------------------------------------------------------------------------
+
+void GUI::post(std::function<void()> command)
+{
+	if (!command) return;
+	// (Counted before pushing, so the count can't drop below the queue size)
+	m_postsPending.fetch_add(1, std::memory_order_relaxed);
+	m_lastPostTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+	m_commands.push(std::move(command));
+}
+
+void GUI::run_posted()
+{
+	std::size_t done = 0;
+	m_commands.drain([&done](std::function<void()>&& command) { ++done; command(); });
+	if (done) m_postsPending.fetch_sub(done, std::memory_order_relaxed);
+}
+
+
 //----------------------------------------------------------------------------
 // Callbacks...
 //----------------------------------------------------------------------------
@@ -497,21 +851,27 @@ void GUI::onTick()
 {
 	m_sessionTime += m_clock.restart();
 
-	//!! Go through the set of registered timer callbacks to check if
-	//!! any of them are (over)due, and call those. (Note: most of them
-	//!! may have requested triggering on (relative) timeouts, rather than
-	//!! on "absolute" session time!)
-	//!! ...
-	//!! Then remove the one-shot hooks:
-	//!! ...
-	//!!-----------------------------------------
-	//!! Or, alternatively(?):
-	//!! Just call every widget's onTick()...
-	//!! Compilers should optimize out the empty default onTick() virtuals... right?... RIGHT???
-	traverse([](Widget* w) {
-		w->onTick();
-		//!!Manual kludge until Widget becomes WidgetContainer, so tooltips can be proper tree nodes:
-		if (w->m_tooltip && w->m_tooltip->armed()) w->m_tooltip->onTick();
+	// Run what the other threads have posted since the last frame
+	run_posted();
+
+	// Fire the timers that have become due (see startTimer())
+	m_timers.advance(timer_now());
+
+	// Tick the widgets that have asked for it (see Widget::requestTicks())
+	// (Everything else is only woken up by its timers, instead of calling
+	// every widget's onTick() on every frame.)
+	Widget::tick_subscribers(this);
+
+	//!!Manual kludge until Widget becomes WidgetContainer, so tooltips can be proper tree nodes:
+	//! Only the active ones need ticking, though. (Not a range-for, as it may be appended to meanwhile.)
+	for (size_t i = 0; i < m_activeTooltips.size(); ++i)
+		m_activeTooltips[i]->onTick();
+
+	// Drop the ones that have been turned off (by the tick, or since the last one)
+	std::erase_if(m_activeTooltips, [](Tooltip* tooltip) {
+		if (tooltip->armed()) return false;
+		tooltip->m_gui = nullptr;
+		return true;
 	});
 }
 
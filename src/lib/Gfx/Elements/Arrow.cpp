@@ -29,6 +29,12 @@ void Arrow::setFillColor([[maybe_unused]] const sf::Color& color)
 //!!        m_vertices[i].color = color;
 }
 
+void Arrow::setColor(const sf::Color& color)
+{
+    for (int i = 0; i < 4; ++i)
+        m_vertices[i].color = color;
+}
+
 
 void Arrow::setPosition(sf::Vector2f pos)
 {
@@ -57,11 +63,16 @@ sf::Vector2f Arrow::getSize() const
 }
 
 
-void Arrow::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+void Arrow::draw(const gfx::RenderContext& ctx) const
 {
-    auto lstates = states;
+    auto lstates = ctx.props;
     lstates.texture = &Theme::getTexture();
-    target.draw(m_vertices, 4, sf::PrimitiveType::TriangleStrip, lstates);
+    ctx.draw(m_vertices, 4, sf::PrimitiveType::TriangleStrip, lstates);
+}
+
+void Arrow::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+    draw(gfx::RenderContext{target, states});
 }
 
 
@@ -3,7 +3,6 @@
 #include "sfw/util/diagnostics.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
 
 #include <cmath>
 
@@ -34,6 +33,8 @@ void Box::setPosition(float x, float y)
     sf::Vector2f diff = sf::Vector2f(x, y) - getPosition();
     for (size_t i = 0; i < VERTEX_COUNT; ++i)
         m_vertices[i].position += diff;
+    for (auto& v : m_fill)
+        v.position += diff;
 }
 
 
@@ -63,6 +64,7 @@ void Box::setSize(float width, float height)
     setSegmentGeometry(TOP_SEGMENT,    0, x1, x2, x3,  0, y1);
     setSegmentGeometry(MIDDLE_SEGMENT, 0, x1, x2, x3, y1, y2);
     setSegmentGeometry(BOTTOM_SEGMENT, 0, x1, x2, x3, y2, y3);
+    updateFillGeometry();
 }
 
 sf::Vector2f Box::getSize() const
@@ -75,6 +77,15 @@ sf::Vector2f Box::getSize() const
 void Box::setFillColor(sf::Color color)
 {
     m_fillColor = color;
+    for (auto& v : m_fill)
+        v.color = color;
+}
+
+
+void Box::setColor(sf::Color color)
+{
+    for (auto& v : m_vertices)
+        v.color = color;
 }
 
 
@@ -126,6 +137,17 @@ void Box::setSegmentTextureCoords(StripSegment n, float txleft, float txtop, flo
 }
 
 
+void Box::updateFillGeometry()
+{
+    auto [x0, y0] = getPosition();
+    auto [x1, y1] = m_vertices[BOTTOM_RIGHT].position;
+    m_fill[0].position = {x0, y0};
+    m_fill[1].position = {x0, y1};
+    m_fill[2].position = {x1, y0};
+    m_fill[3].position = {x1, y1};
+}
+
+
 // Visual properties -----------------------------------------------------------
 
 void Box::applyState(ActivationState state)
@@ -154,27 +176,24 @@ void Box::applyState(ActivationState state)
 }
 
 
-void Box::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+void Box::draw(const gfx::RenderContext& ctx) const
 {
-    auto lstates = states;
+    auto lstates = ctx.props;
     lstates.texture = &Theme::getTexture();
-    target.draw(m_vertices, VERTEX_COUNT, sf::PrimitiveType::TriangleStrip, lstates);
+    ctx.draw(m_vertices, VERTEX_COUNT, sf::PrimitiveType::TriangleStrip, lstates);
     // Overdraw the with a filled rect (presumably with some alpha!) if fillColor was set:
     if (m_fillColor)
     {
-/*
-        sf::RectangleShape r(sf::Vector2f(getSize().x - 2 * (float)Theme::borderSize,
-                                          getSize().y - 2 * (float)Theme::borderSize));
-	r.setPosition(getPosition()); r.move({(float)Theme::borderSize, (float)Theme::borderSize});
-*/
-        sf::RectangleShape r(sf::Vector2f(getSize().x, getSize().y));
-	r.setPosition(getPosition());
-	r.setFillColor(m_fillColor.value());
-	r.setOutlineThickness(0);
-	target.draw(r, lstates);
+        lstates.texture = nullptr;
+        ctx.draw(m_fill, 4, sf::PrimitiveType::TriangleStrip, lstates);
     }
 }
 
+void Box::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+    draw(gfx::RenderContext{target, states});
+}
+
 
 void Box::centerTextHorizontally(sf::Text& text)
 {
@@ -60,11 +60,16 @@ void CheckMark::setColor(const sf::Color& color)
 }
 
 
-void CheckMark::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+void CheckMark::draw(const gfx::RenderContext& ctx) const
 {
-    auto lstates = states;
+    auto lstates = ctx.props;
     lstates.texture = &Theme::getTexture();
-    target.draw(m_vertices, 4, sf::PrimitiveType::TriangleStrip, lstates);
+    ctx.draw(m_vertices, 4, sf::PrimitiveType::TriangleStrip, lstates);
+}
+
+void CheckMark::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
+{
+    draw(gfx::RenderContext{target, states});
 }
 
 
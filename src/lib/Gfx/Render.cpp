@@ -0,0 +1,359 @@
+#include "sfw/Gfx/Render.hpp"
+
+#include <SFML/OpenGL.hpp>
+
+#include <algorithm>
+	using std::min, std::max;
+#include <cmath>
+#include <cassert>
+#include <iostream>
+	using std::cerr;
+
+namespace sfw::gfx
+{
+
+//----------------------------------------------------------------------------
+RenderContext RenderContext_base<SFML>::clipped(const sf::FloatRect& rect) const
+{
+	auto r = props.transform.transformRect(rect);
+	int left   = (int)std::floor(r.left),            top    = (int)std::floor(r.top);
+	int right  = (int)std::ceil(r.left + r.width),   bottom = (int)std::ceil(r.top + r.height);
+	if (clip)
+	{
+		left  = max(left, clip->left);               top    = max(top, clip->top);
+		right = min(right, clip->left + clip->width); bottom = min(bottom, clip->top + clip->height);
+	}
+	// (An empty intersection is fine: it would just clip everything.)
+	return {target, props, renderer, sf::IntRect({left, top}, {max(0, right - left), max(0, bottom - top)})};
+}
+
+
+//----------------------------------------------------------------------------
+void Renderer::begin(sf::RenderTarget& target)
+{
+	m_target = &target;
+	m_clipRect.reset();
+	m_drawCalls = 0;
+	reset();
+}
+
+void Renderer::reset()
+{
+	m_commands.clear();
+	m_batchCommands.clear();
+	for (size_t i = 0; i < m_batchesUsed; ++i) m_batches[i].clear(); // Keeps the capacity
+	m_batchesUsed = 0;
+
+	auto size = m_target->getSize();
+	m_zgridCols = (size.x + ZGRID_CELL_SIZE - 1) / ZGRID_CELL_SIZE;
+	m_zgridRows = (size.y + ZGRID_CELL_SIZE - 1) / ZGRID_CELL_SIZE;
+	m_zgrid.assign((size_t)m_zgridCols * m_zgridRows, 0);
+}
+
+
+//----------------------------------------------------------------------------
+void Renderer::submit(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+	assert(m_target);
+
+	using enum sf::PrimitiveType;
+	if (type != Triangles && type != TriangleStrip && type != TriangleFan)
+	{
+		// Can't batch these, so just preserve the Z-order:
+		flush();
+		if (m_clipRect) applyClipRect(*m_target, m_clipRect);
+		m_target->draw(vertices, count, type, states);
+		if (m_clipRect) applyClipRect(*m_target, std::nullopt);
+		++m_drawCalls;
+		return;
+	}
+	if (count < 3)
+		return;
+
+	// Find the latest batch with matching states, if any
+	size_t cmd_index = m_commands.size();
+	for (auto i = m_batchCommands.rbegin(); i != m_batchCommands.rend(); ++i)
+	{
+		if (batchable(m_commands[*i], states)) { cmd_index = *i; break; }
+	}
+
+	// Transform the geometry to target coordinates (so batches can be drawn
+	// with an identity transform), and find its bounding box
+	//!! This copy could be avoided by transforming directly into the batch,
+	//!! and rolling back if the batch turns out to be blocked...
+	thread_local std::vector<sf::Vertex> transformed;
+	transformed.resize(count);
+	sf::FloatRect bounds;
+	float right = 0, bottom = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		transformed[i] = vertices[i];
+		auto& p = transformed[i].position;
+		p = states.transform.transformPoint(p);
+		if (i == 0) { bounds.left = right = p.x; bounds.top = bottom = p.y; }
+		else {
+			bounds.left = min(bounds.left, p.x); right  = max(right, p.x);
+			bounds.top  = min(bounds.top,  p.y); bottom = max(bottom, p.y);
+		}
+	}
+	bounds.width = right - bounds.left;
+	bounds.height = bottom - bounds.top;
+
+	// Merging into that batch would draw this geometry earlier than requested,
+	// which is only OK if nothing queued since then overlaps it:
+	if (cmd_index == m_commands.size() || topmost(bounds) > cmd_index + 1)
+	{
+		if (m_batchesUsed == m_batches.size())
+			m_batches.emplace_back(sf::PrimitiveType::Triangles);
+		auto lstates = states;
+		lstates.transform = sf::Transform::Identity;
+		cmd_index = m_commands.size();
+		m_commands.push_back({nullptr, lstates, m_batchesUsed++, m_clipRect});
+		m_batchCommands.push_back(cmd_index);
+	}
+	cover(bounds, cmd_index + 1);
+
+	// Convert to a plain triangle list, dropping degenerate triangles (e.g.
+	// the "carriage returns" of multi-row strips)
+	auto& batch = m_batches[m_commands[cmd_index].batch];
+	auto append = [&batch](const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c) {
+		if (a.position == b.position || b.position == c.position || a.position == c.position)
+			return;
+		batch.append(a); batch.append(b); batch.append(c);
+	};
+	switch (type)
+	{
+	case Triangles:
+		for (size_t i = 0; i + 2 < count; i += 3) append(transformed[i], transformed[i+1], transformed[i+2]);
+		break;
+	case TriangleStrip:
+		for (size_t i = 2; i < count; ++i) append(transformed[i-2], transformed[i-1], transformed[i]);
+		break;
+	case TriangleFan:
+		for (size_t i = 2; i < count; ++i) append(transformed[0], transformed[i-1], transformed[i]);
+		break;
+	default:;
+	}
+}
+
+
+//----------------------------------------------------------------------------
+void Renderer::queue(const sf::Drawable& object, const sf::RenderStates& states, const std::optional<sf::FloatRect>& bounds)
+{
+	assert(m_target);
+
+	m_commands.push_back({&object, states, 0, m_clipRect});
+	cover(bounds, m_commands.size());
+}
+
+
+//----------------------------------------------------------------------------
+void Renderer::flush()
+{
+	if (!m_target) return;
+
+	std::optional<sf::IntRect> clip; // No scissoring initially
+	for (auto& cmd : m_commands)
+	{
+		if (cmd.clip != clip)
+		{
+			applyClipRect(*m_target, cmd.clip);
+			clip = cmd.clip;
+		}
+
+		if (cmd.object)
+		{
+			m_target->draw(*cmd.object, cmd.states);
+		}
+		else
+		{
+			auto& batch = m_batches[cmd.batch];
+			if (!batch.getVertexCount()) continue;
+			m_target->draw(batch, cmd.states);
+		}
+		++m_drawCalls;
+	}
+	if (clip) applyClipRect(*m_target, std::nullopt);
+
+	// Keep drawing into the same target (with the same clipping) after this
+	reset();
+}
+
+
+//----------------------------------------------------------------------------
+bool Renderer::batchable(const Command& cmd, const sf::RenderStates& states) const
+{
+	return cmd.states.texture   == states.texture
+	    && cmd.states.shader    == states.shader
+	    && cmd.states.blendMode == states.blendMode
+	    && cmd.clip == m_clipRect;
+}
+
+
+//----------------------------------------------------------------------------
+void Renderer::cellRange(const sf::FloatRect& bounds, unsigned& x0, unsigned& y0, unsigned& x1, unsigned& y1) const
+{
+	assert(m_zgridCols && m_zgridRows);
+	auto clamp_col = [this](float x) { return (unsigned)std::clamp(x / ZGRID_CELL_SIZE, 0.f, float(m_zgridCols - 1)); };
+	auto clamp_row = [this](float y) { return (unsigned)std::clamp(y / ZGRID_CELL_SIZE, 0.f, float(m_zgridRows - 1)); };
+	x0 = clamp_col(std::floor(bounds.left));
+	y0 = clamp_row(std::floor(bounds.top));
+	x1 = clamp_col(std::ceil(bounds.left + bounds.width));
+	y1 = clamp_row(std::ceil(bounds.top + bounds.height));
+}
+
+size_t Renderer::topmost(const std::optional<sf::FloatRect>& bounds) const
+{
+	if (!m_zgridCols || !m_zgridRows) return 0;
+	unsigned x0 = 0, y0 = 0, x1 = m_zgridCols - 1, y1 = m_zgridRows - 1;
+	if (bounds) cellRange(*bounds, x0, y0, x1, y1);
+
+	uint32_t z = 0;
+	for (auto y = y0; y <= y1; ++y)
+		for (auto x = x0; x <= x1; ++x)
+			z = max(z, m_zgrid[(size_t)y * m_zgridCols + x]);
+	return z;
+}
+
+void Renderer::cover(const std::optional<sf::FloatRect>& bounds, size_t z)
+{
+	if (!m_zgridCols || !m_zgridRows) return;
+	unsigned x0 = 0, y0 = 0, x1 = m_zgridCols - 1, y1 = m_zgridRows - 1;
+	if (bounds) cellRange(*bounds, x0, y0, x1, y1);
+
+	for (auto y = y0; y <= y1; ++y)
+		for (auto x = x0; x <= x1; ++x)
+		{
+			auto& cell = m_zgrid[(size_t)y * m_zgridCols + x];
+			cell = max(cell, (uint32_t)z);
+		}
+}
+
+
+//----------------------------------------------------------------------------
+void applyClipRect(sf::RenderTarget& target, const std::optional<sf::IntRect>& rect)
+{
+	// The scissor state belongs to the target's GL context, which may not be
+	// the current one (e.g. after having drawn to some other (offscreen) target)
+	if (!target.setActive(true))
+		return;
+
+	if (!rect)
+	{
+		glDisable(GL_SCISSOR_TEST);
+		return;
+	}
+
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(
+		(GLint)rect->left,
+		(GLint)(target.getSize().y - (rect->top + rect->height)), // GL's origin is bottom-left
+		(GLsizei)max(0, rect->width), // glScissor will fail if < 0!
+		(GLsizei)max(0, rect->height)
+	);
+}
+
+
+//============================================================================
+bool Layer::paint(sf::Vector2f size, const Painter& paint)
+{
+	sf::Vector2u texsize{(unsigned)std::ceil(max(0.f, size.x)), (unsigned)std::ceil(max(0.f, size.y))};
+	if (!texsize.x || !texsize.y)
+	{
+		m_painted = false;
+		return false;
+	}
+
+	auto& texture = m_textures[m_front];
+	if (texture.getSize() != texsize)
+	{
+		if (!texture.create(texsize))
+		{
+			cerr << "- ERROR: Failed to create offscreen layer of "
+			     << texsize.x << " x " << texsize.y << " pixels!\n";
+			m_painted = false;
+			return false;
+		}
+		auto [w, h] = sf::Vector2f(texsize);
+		m_quad[0] = {{0, 0}, sf::Color::White, {0, 0}};
+		m_quad[1] = {{0, h}, sf::Color::White, {0, h}};
+		m_quad[2] = {{w, 0}, sf::Color::White, {w, 0}};
+		m_quad[3] = {{w, h}, sf::Color::White, {w, h}};
+	}
+
+	texture.clear(sf::Color::Transparent);
+	m_renderer.begin(texture);
+	// (Clipping to the texture is a no-op for drawing, but lets the painter
+	// know what's visible)
+	paint(RenderContext{texture, sf::RenderStates(), &m_renderer, sf::IntRect({0, 0}, sf::Vector2i(texsize))});
+	m_renderer.flush();
+	texture.display();
+
+	m_painted = true;
+	return true;
+}
+
+bool Layer::scroll(sf::Vector2f offset, const Painter& paint)
+{
+	if (!m_painted)
+		return false;
+
+	auto& front = m_textures[m_front];
+	auto& back  = m_textures[1 - m_front];
+	auto size = sf::Vector2f(front.getSize());
+	offset = {std::round(offset.x), std::round(offset.y)};
+	if (std::abs(offset.x) >= size.x || std::abs(offset.y) >= size.y)
+		return false;
+
+	if (back.getSize() != front.getSize() && !back.create(front.getSize()))
+	{
+		cerr << "- ERROR: Failed to create offscreen layer backbuffer of "
+		     << size.x << " x " << size.y << " pixels!\n";
+		return false;
+	}
+
+	// Copy the content to keep, as is (no blending, as it's premultiplied already)
+	back.clear(sf::Color::Transparent);
+	sf::RenderStates blit(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::Zero));
+	blit.texture = &front.getTexture();
+	blit.transform.translate(offset);
+	back.draw(m_quad, 4, sf::PrimitiveType::TriangleStrip, blit);
+
+	// Paint the uncovered strips (the top/bottom one spanning the full width,
+	// the left/right one only what's left of the height)
+	m_renderer.begin(back);
+	RenderContext ctx{back, sf::RenderStates(), &m_renderer, sf::IntRect({0, 0}, sf::Vector2i(front.getSize()))};
+	float rows_top = 0, rows_height = size.y;
+	if (offset.y > 0)
+	{
+		paint(ctx.clipped({{0, 0}, {size.x, offset.y}}));
+		rows_top = offset.y; rows_height -= offset.y;
+	}
+	else if (offset.y < 0)
+	{
+		paint(ctx.clipped({{0, size.y + offset.y}, {size.x, -offset.y}}));
+		rows_height += offset.y;
+	}
+	if (offset.x > 0)      paint(ctx.clipped({{0, rows_top}, {offset.x, rows_height}}));
+	else if (offset.x < 0) paint(ctx.clipped({{size.x + offset.x, rows_top}, {-offset.x, rows_height}}));
+	m_renderer.flush();
+	back.display();
+
+	m_front = 1 - m_front;
+	return true;
+}
+
+void Layer::draw(const RenderContext& ctx, const sf::RenderStates& states) const
+{
+	if (!m_painted)
+		return;
+
+	// Alpha-blending onto the transparent texture has left the colors
+	// premultiplied by alpha, so they must not be multiplied again:
+	auto lstates = states;
+	lstates.texture = &m_textures[m_front].getTexture();
+	lstates.blendMode = sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+	ctx.draw(m_quad, 4, sf::PrimitiveType::TriangleStrip, lstates);
+}
+
+} // namespace sfw::gfx
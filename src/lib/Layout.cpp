@@ -4,6 +4,10 @@
 #include "sfw/Gfx/Render.hpp"
 #include "sfw/util/shim/sfml.hpp" // for sf::Event::KeyEvent::==
 
+#include <algorithm>
+	using std::max;
+#include <limits>
+
 #ifdef DEBUG
 #   include "sfw/GUI-main.hpp"
 #   include <iostream>
@@ -34,7 +38,7 @@ void Layout::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	gfx::RenderContext lctx{ctx.target, sfml_renderstates};
+	gfx::RenderContext lctx{ctx.target, sfml_renderstates, ctx.renderer, ctx.clip};
 
 #ifdef DEBUG
 	if (DEBUG_INSIGHT_KEY_PRESSED && getActivationState() == Hovered) {
@@ -46,9 +50,58 @@ void Layout::draw(const gfx::RenderContext& ctx) const
 	}
 #endif
 
-	cforeach([&](auto* widget) {
+	bool use_cache = (bool)m_cache;
+#ifdef DEBUG
+	if (DEBUG_INSIGHT_KEY_PRESSED) use_cache = false; // Don't bake the debug overlays into the cache!
+#endif
+	if (use_cache)
+	{
+		// Repaint only if something has changed in the subtree since the last
+		// time (our own dirty flag rolls up from the descendants)
+		if (dirty() || !m_cache->painted())
+		{
+			m_cache->paint(getSize(), [this](const gfx::RenderContext& cctx) { draw_children(cctx); });
+		}
+		if (m_cache->painted())
+		{
+			m_cache->draw(lctx, sfml_renderstates);
+			return;
+		}
+		// Couldn't paint it (e.g. empty), so just draw it directly then...
+	}
+
+	draw_children(lctx);
+}
+
+
+void Layout::draw_children(const gfx::RenderContext& lctx) const
+{
+	auto culled = [&lctx](const Widget* widget) {
+		if (!lctx.clip) return false;
+		auto r = lctx.props.transform.transformRect({widget->getPosition(), widget->getSize()});
+		const auto& clip = *lctx.clip;
+		return r.left >= float(clip.left + clip.width)  || r.left + r.width  <= float(clip.left)
+		    || r.top  >= float(clip.top  + clip.height) || r.top  + r.height <= float(clip.top);
+	};
+
+	for (const Widget* widget : *this)
+	{
+		if (culled(widget))
+		{
+			//! Still clear the flags (of the whole subtree, as a dirty widget
+			//! must always have dirty ancestors), to keep them in sync with
+			//! ours (it will be drawn in its current state, whenever it gets
+			//! in view)
+			widget->m_dirty = false;
+			widget->ctraverse([](const Widget* w) { w->m_dirty = false; });
+			continue;
+		}
+
 		if (m_hoveredWidget != widget) 	//! Defer the hovered one, for "cheating" the Z-order; see below...
+		{
 			widget->draw(lctx);
+			widget->m_dirty = false;
+		}
 #ifdef DEBUG
 		// "Dim" the widget rect. if disabled:
 		if (widget->disabled()) {
@@ -69,12 +122,15 @@ void Layout::draw(const gfx::RenderContext& ctx) const
 			}
 		}
 #endif
-	});
+	}
 
 	//! Draw the hovered item (which is often just a container) last, to win the Z-order! :)
 	//!! But this z-order disturbance may be way too aggressive IRL! Test with real overlapping crap!
-	if (m_hoveredWidget)
+	if (m_hoveredWidget && !culled(m_hoveredWidget))
+	{
 		m_hoveredWidget->draw(lctx);
+		m_hoveredWidget->m_dirty = false;
+	}
 
 	// Separate round for tooltips, to ensure they're on the top...
 	//!! Alas, they can still be covered by any other layout that may be above in the Z-order!
@@ -130,47 +186,27 @@ void Layout::onMouseMoved(float x, float y)
 		return;
 	}
 
-	for (Widget* widget = begin(); widget != end(); widget = next(widget)) //!! Not a nice fit for foreachb(), as it would
-	                                                                       //!! quickly become way more convoluted than this
-	                                                                       //!! simple form, due to that early return & continue!
-									       //!! -> #318
+	if (Widget* widget = childAt({x, y}); widget)
 	{
-		if (!widget->enabled())
-			continue;
-
 		// Translate mouse pos. to child-local
 		sf::Vector2f localPos = sf::Vector2f(x, y) - widget->getPosition();
 
-		if (widget->contains(localPos))
+		if (widget != m_hoveredWidget) // Hovered to another widget?
 		{
-			if (widget != m_hoveredWidget) // Hovered to another widget?
-			{
-				hover(widget, x, y);
-/*!!
-auto gM = getMain()->getMousePosition();
-auto wA = widget->getAbsolutePosition();
-auto m = gM - wA;
-	//!!m += getMain()->getAbsolutePosition();
-cerr << "LOCAL MOUSE [Layout]: " << m.x << ", " << m.y << endl;
-//cerr << "W abs: " << wA.x << ", " << wA.y << endl;
-!!*/
-			}
-			//else //! With this `else` still in place, some cases of #45 were still missed!
-			       //! Note: hover() above could also just be recursive (like unhover() is!),
-			       //! or at least call onMouseMoved internally to trigger the recursion, but
-			       //! it doesn't have `localPos` handy, so best to just do that here:
-			{
-				widget->onMouseMoved(localPos.x, localPos.y);
-
-				//! NOTE: If tooltip cancellation would ever be moved (back) here:
-				//! Not checking for visible() would prevent tooltips from *appearing* at all,
-				//! because MouseMove events typically follow a MouseEnter immediately,
-				//! i.e. while the tooltip has been armed (delayed), but not yet visible!
-			}
-			return;
-
-		} // if (contains)
-	} // for
+			hover(widget, x, y);
+		}
+		//! No `else` here! With that still in place, some cases of #45 were still missed!
+		//! Note: hover() above could also just be recursive (like unhover() is!),
+		//! or at least call onMouseMoved internally to trigger the recursion, but
+		//! it doesn't have `localPos` handy, so best to just do that here:
+		widget->onMouseMoved(localPos.x, localPos.y);
+
+		//! NOTE: If tooltip cancellation would ever be moved (back) here:
+		//! Not checking for visible() would prevent tooltips from *appearing* at all,
+		//! because MouseMove events typically follow a MouseEnter immediately,
+		//! i.e. while the tooltip has been armed (delayed), but not yet visible!
+		return;
+	}
 
 	// No widget is hovered now, so reset the last hovered one
 	unhover();
@@ -199,26 +235,16 @@ void Layout::onMousePressed(float x, float y)
 	//
 	if (!m_hoveredWidget)
 	{
-		for (Widget* widget = begin(); widget != end(); widget = next(widget)) //!! Not a nice fit for foreachb() (-> #318),
-		                                                                       //!! because of an early break-out!
+		if (Widget* widget = childAt({x, y}); widget)
 		{
-			if (widget->enabled())
-			{
-				// Translate mouse pos. to child-local
-				sf::Vector2f localPos = sf::Vector2f(x, y) - widget->getPosition();
-				if (widget->contains(localPos))
-				{
 //!! This is *still* necessary, even after recursifying hover (to finally
 //!! propagate through a container chain down to the target widget)!... :-o
-					hover(widget, x, y);
+			hover(widget, x, y);
 //!! (I HAVE SEEN THIS MESSAGE both in e.g. the OON control panel, and in the sfw test app!)
 #ifdef DEBUG
 cerr << "- [sfw::Layout::onMousePressed] Oops, missed hover retroactively fixed!\n";
 #endif
-					assert(m_hoveredWidget);
-					break;
-				}
-			}
+			assert(m_hoveredWidget);
 		}
 	}
 
@@ -257,17 +283,20 @@ void Layout::onMouseReleased(float x, float y)
 	{
 		sf::Vector2f localMousePos = sf::Vector2f(x, y) - m_focusedWidget->getPosition();
 		m_focusedWidget->onMouseReleased(localMousePos.x, localMousePos.y);
-		m_focusedWidget->setActivationState(Focused);
+		// The handler (e.g. a button callback) may have detached or removed
+		// the widget (which also unfocuses it), so check again:
+		if (m_focusedWidget)
+			m_focusedWidget->setActivationState(Focused);
 	}
 }
 
 
 void Layout::onMouseWheelMoved(int delta)
 {
-	if (m_focusedWidget)
-	{
-		m_focusedWidget->onMouseWheelMoved(delta);
-	}
+	// The wheel goes to what's under the mouse (not to the focused child,
+	// which may be anywhere), and bubbles back up if nothing there wants it
+	if (!m_hoveredWidget || !m_hoveredWidget->enabled() || !offer_wheel(m_hoveredWidget, delta))
+		decline_wheel();
 }
 
 
@@ -324,6 +353,18 @@ void Layout::onTextEntered(char32_t unichar)
 
 // API -----------------------------------------------------------------------
 
+//----------------------------------------------------------------------------
+Layout* Layout::setCacheAsBitmap(bool enable)
+{
+	if (enable == cachedAsBitmap())
+		return this;
+
+	if (enable) m_cache = std::make_unique<gfx::Layer>();
+	else        m_cache.reset();
+	invalidate();
+	return this;
+}
+
 //----------------------------------------------------------------------------
 bool Layout::focused() const //override
 {
@@ -358,9 +399,9 @@ bool Layout::focusNext()
 
 	// Still here? The child couldn't handle the focus change. Try further in this container then...
 
-	Widget* start = m_focusedWidget ? next(m_focusedWidget) : begin();
+	Widget* start = m_focusedWidget ? next(m_focusedWidget) : first();
 
-	for (Widget* widget = start; widget != end(); widget = next(widget))
+	for (Widget* widget = start; widget; widget = next(widget))
 	{
 		if (Layout* container = widget->toLayout(); container)
 		{
@@ -394,9 +435,9 @@ bool Layout::focusPrevious()
 
 	// Still here? The child couldn't handle the focus change. Try further in this container then...
 
-	Widget* start = m_focusedWidget ? prev(m_focusedWidget) : rbegin();
+	Widget* start = m_focusedWidget ? prev(m_focusedWidget) : last();
 
-	for (Widget* widget = start; widget != rend(); widget = prev(widget))
+	for (Widget* widget = start; widget; widget = prev(widget))
 	{
 		if (Layout* container = widget->toLayout(); container)
 		{
@@ -439,6 +480,18 @@ void Layout::unfocus()
 }
 
 
+//----------------------------------------------------------------------------
+void Layout::forget_child(Widget* child)
+{
+	if (child == m_hoveredWidget) unhover(); // (Recursive, so a layout child is cleaned up, too)
+	if (child == m_focusedWidget) unfocus(); // (Ditto.)
+
+	// The hit-test index would be rebuilt by the next layout pass anyway, but
+	// must not point to the child even until then:
+	m_hitIndex.clear();
+}
+
+
 //----------------------------------------------------------------------------
 void Layout::hover(Widget* widget, float parent_x, float parent_y)
 {
@@ -463,6 +516,77 @@ void Layout::hover(Widget* widget, float parent_x, float parent_y)
 		widget->m_tooltip->arm(parent_x, parent_y); // Parent of the tooltip owner!
 }
 
+//----------------------------------------------------------------------------
+Widget* Layout::childAt(const sf::Vector2f& pos) const
+{
+	auto hit = [&pos](Widget* widget) {
+		// Translate pos. to child-local
+		return widget->enabled() && widget->contains(pos - widget->getPosition());
+	};
+
+	if (m_hitIndex.empty() || geometryDirty())
+	{
+		for (Widget* widget : *this)
+		{
+			if (hit(widget)) return widget;
+		}
+		return nullptr;
+	}
+
+	float p = m_hitAxis == Horizontal ? pos.x : pos.y;
+
+	// Find the spans starting before `p`, then walk back as long as any of
+	// those could still reach it. The earliest child hit wins (like with the
+	// linear scan), in case some of them overlap.
+	auto span = std::upper_bound(m_hitIndex.begin(), m_hitIndex.end(), p,
+		[](float p, const HitSpan& span) { return p < span.from; });
+	Widget* found = nullptr;
+	while (span != m_hitIndex.begin() && (--span)->reach > p)
+	{
+		if (hit(span->widget)) found = span->widget;
+	}
+	return found;
+}
+
+
+void Layout::indexChildren(Orientation axis)
+{
+	m_hitIndex.clear();
+	m_hitAxis = axis;
+
+	if (size() < HIT_INDEX_MIN_CHILDREN)
+		return;
+
+	m_hitIndex.reserve(size());
+	float reach = std::numeric_limits<float>::lowest();
+	for (Widget* widget : *this)
+	{
+		float from = axis == Horizontal ? widget->getPosition().x : widget->getPosition().y;
+		float to = from + (axis == Horizontal ? widget->getSize().x : widget->getSize().y);
+
+		if (!m_hitIndex.empty() && from < m_hitIndex.back().from)
+		{
+			// Not in order along this axis, so the binary search wouldn't work
+#ifdef DEBUG
+cerr << "- Warning: [sfw::Layout::indexChildren] children not in position order, can't index them!\n";
+#endif
+			m_hitIndex.clear();
+			return;
+		}
+
+		reach = max(reach, to);
+		m_hitIndex.push_back({from, to, reach, widget});
+	}
+}
+
+
+void Layout::moveChild(Widget* child, const sf::Vector2f& pos)
+{
+	assert(child && child->getParent() == this);
+	child->set_position(pos);
+}
+
+
 //----------------------------------------------------------------------------
 void Layout::unhover()
 {
@@ -64,7 +64,7 @@ Widget* Form::add(Widget* label, Widget* widget, const std::string& widgetName,
 
 void Form::recomputeGeometry()
 {
-	if (empty()) return;
+	if (empty()) { indexChildren(Vertical); return; }
 
 	sf::Vector2f size{};
 	m_labelColumnWidth = 0;
@@ -75,8 +75,8 @@ void Form::recomputeGeometry()
 	// Resize container...
 
 	// Grow height & width to accomodate content, and find the widest label, too...
-	for (Widget *label = begin(), *content = next(begin());
-		label != end() && content != end();
+	for (Widget *label = first(), *content = next(label);
+		label && content;
 		label = next(content), content = next(label))
 	{
 		auto lineHeight = minLineHeight;
@@ -98,8 +98,8 @@ void Form::recomputeGeometry()
 	// Position children...
 	
 	float y = 0;
-	for (Widget *label = begin(), *content = next(begin());
-		label != end() && content != end();
+	for (Widget *label = first(), *content = next(label);
+		label && content;
 		label = next(content), content = next(label))
 	{
 		label->setPosition(0, y);
@@ -117,6 +117,8 @@ void Form::recomputeGeometry()
 		lineHeight = max(lineHeight, content->getSize().y);
 		y += lineHeight + Theme::MARGIN;
 	}
+
+	indexChildren(Vertical); // Each row is at the same y, in order
 }
 
 
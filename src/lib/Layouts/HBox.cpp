@@ -20,6 +20,8 @@ void HBox::recomputeGeometry()
     });
     size.x = max(0.f, pos.x - Theme::MARGIN); // 0 for an empty container
     Widget::setSize(size);
+
+    indexChildren(Horizontal);
 }
 
 } // namespace
@@ -0,0 +1,122 @@
+#include "sfw/Layouts/ScrollArea.hpp"
+#include "sfw/Theme.hpp"
+
+#include <algorithm>
+	using std::max, std::clamp;
+#include <cmath>
+
+namespace sfw
+{
+
+ScrollArea::ScrollArea(sf::Vector2f viewportSize):
+	m_viewportSize(viewportSize)
+{
+}
+
+
+ScrollArea* ScrollArea::setViewportSize(sf::Vector2f size)
+{
+	m_viewportSize = size;
+	invalidateGeometry();
+	return this;
+}
+
+
+float ScrollArea::max_scroll() const
+{
+	return max(0.f, m_contentHeight - getSize().y);
+}
+
+
+ScrollArea* ScrollArea::scrollTo(float y)
+{
+	y = std::round(clamp(y, 0.f, max_scroll()));
+	if (y == m_scroll)
+		return this;
+
+	// Only move the children, but don't invalidate them: they haven't changed,
+	// and (if cached as bitmap) this way we can tell that only the newly
+	// uncovered part of the viewport needs to be repainted
+	auto delta = m_scroll - y;
+	foreach([&](Widget* w) { moveChild(w, w->getPosition() + sf::Vector2f(0, delta)); });
+	m_scroll = y;
+	indexChildren(Vertical);
+
+	// Whatever was hovered has now likely moved away from under the mouse
+	unhover();
+
+	// Get redrawn (see above why not just invalidate())
+	if (!isRoot()) getParent()->invalidate();
+	else invalidate();
+
+	return this;
+}
+
+
+//----------------------------------------------------------------------------
+void ScrollArea::recomputeGeometry()
+{
+	// Stack the children like VBox, just starting at the scroll pos.
+	sf::Vector2f pos{0, -m_scroll};
+	float width = 0;
+	foreach([&](Widget* w) {
+		w->setPosition(pos);
+		pos.y += w->getSize().y + Theme::MARGIN;
+		width = max(width, w->getSize().x);
+	});
+	m_contentHeight = max(0.f, pos.y + m_scroll - Theme::MARGIN);
+
+	Widget::setSize(m_viewportSize.x > 0 ? m_viewportSize.x : width, m_viewportSize.y);
+
+	// The content may have shrunk below the scroll pos.
+	if (m_scroll > max_scroll())
+		scrollTo(max_scroll());
+
+	indexChildren(Vertical);
+}
+
+
+void ScrollArea::draw(const gfx::RenderContext& ctx) const
+{
+	auto lctx = ctx.clipped({getPosition(), getSize()});
+	lctx.props.transform *= getTransform();
+
+	if (m_cache)
+	{
+		auto paint = [this](const gfx::RenderContext& cctx) { draw_children(cctx); };
+
+		// Repaint everything if something has changed, otherwise just what's
+		// been scrolled into view (if anything)
+		if (dirty() || !m_cache->painted())
+			m_cache->paint(getSize(), paint);
+		else if (m_paintedScroll != m_scroll && !m_cache->scroll({0, m_paintedScroll - m_scroll}, paint))
+			m_cache->paint(getSize(), paint);
+		m_paintedScroll = m_scroll;
+
+		if (m_cache->painted())
+		{
+			m_cache->draw(lctx, lctx.props);
+			return;
+		}
+		// Couldn't paint it (e.g. empty), so just draw it directly then...
+	}
+
+	draw_children(lctx);
+}
+
+
+void ScrollArea::onMouseWheelMoved(int delta)
+{
+	// The content under the mouse has the first pick (e.g. a focused Slider,
+	// or a nested scroller)
+	if (auto* child = hoveredChild(); child && child->enabled() && offer_wheel(child, delta))
+		return;
+
+	// Scroll, or let the outer scrollers have it, if already at the end
+	auto before = scrollPosition();
+	scroll(-float(delta) * 3 * (float)Theme::getLineSpacing());
+	if (scrollPosition() == before)
+		decline_wheel();
+}
+
+} // namespace
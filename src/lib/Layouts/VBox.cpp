@@ -20,6 +20,8 @@ void VBox::recomputeGeometry()
     });
     size.y = max(0.f, pos.y - Theme::MARGIN); // 0 for an empty container
     Widget::setSize(size);
+
+    indexChildren(Vertical);
 }
 
 } // namespace
@@ -0,0 +1,257 @@
+#include "sfw/TimerWheel.hpp"
+
+#include <algorithm>
+	using std::min, std::max;
+#include <utility>
+	using std::move;
+#include <cassert>
+
+namespace sfw
+{
+
+//----------------------------------------------------------------------------
+TimerWheel::Id TimerWheel::start(Tick due, Tick period, Callback callback)
+{
+	if (m_slots[0].empty()) // First use
+	{
+		m_slots[0].assign(L0_SIZE, -1);
+		for (unsigned l = 1; l < LEVELS; ++l) m_slots[l].assign(LN_SIZE, -1);
+	}
+
+	std::uint32_t index;
+	if (!m_free.empty()) { index = m_free.back(); m_free.pop_back(); }
+	else                 { index = (std::uint32_t)m_timers.size(); m_timers.emplace_back(); }
+
+	auto& t = m_timers[index];
+	t.callback = move(callback);
+	t.due = due;
+	t.period = period;
+	t.active = true;
+	++m_count;
+	link(index);
+
+	return {index, t.generation};
+}
+
+
+bool TimerWheel::stop(Id id)
+{
+	if (!pending(id))
+		return false;
+
+	if ((std::int32_t)id.index == m_firing)
+	{
+		// Just mark it; fire() will clean up after the callback has returned
+		m_timers[id.index].active = false;
+		return true;
+	}
+
+	unlink(id.index);
+	release(id.index);
+	return true;
+}
+
+
+bool TimerWheel::pending(Id id) const
+{
+	return id && id.index < m_timers.size()
+		&& m_timers[id.index].generation == id.generation
+		&& m_timers[id.index].active;
+}
+
+
+//----------------------------------------------------------------------------
+void TimerWheel::advance(Tick now)
+{
+	while (m_current <= now)
+	{
+		if (!m_count)
+		{
+			m_current = now + 1;
+			break;
+		}
+
+		// Skip to the next time anything can happen, if the finer levels are empty
+		unsigned level = 0;
+		while (level < LEVELS - 1 && !m_levelCount[level]) ++level;
+		if (level > 0)
+		{
+			Tick span = Tick(1) << shift(level);
+			Tick next = (m_current | (span - 1)) + 1;
+			if (m_current & (span - 1)) // Not at a boundary already?
+			{
+				if (next > now) { m_current = now + 1; break; }
+				m_current = next;
+			}
+		}
+
+		// Bring the next stretch down from the coarser levels, when the
+		// finest one has wrapped around
+		if (!(m_current & L0_MASK))
+		{
+			for (unsigned l = 1; l < LEVELS; ++l)
+			{
+				auto slot = (std::size_t)((m_current >> shift(l)) & LN_MASK);
+				cascade(l, slot);
+				if (slot) break;
+			}
+		}
+
+		// Fire what's due now (new timers started by the callbacks never go
+		// into this slot, so this will terminate)
+		auto& head = m_slots[0][m_current & L0_MASK];
+		while (head != -1)
+		{
+			auto index = (std::uint32_t)head;
+			unlink(index);
+			fire(index);
+		}
+
+		++m_current;
+	}
+}
+
+
+std::optional<TimerWheel::Tick> TimerWheel::nextDue() const
+{
+	if (!m_count)
+		return std::nullopt;
+
+	std::optional<Tick> result;
+
+	// Level 0: each slot maps to a single tick
+	if (m_levelCount[0])
+	{
+		for (Tick i = 0; i < L0_SIZE; ++i)
+		{
+			if (m_slots[0][(m_current + i) & L0_MASK] != -1)
+			{
+				result = m_current + i;
+				break;
+			}
+		}
+	}
+
+	// Coarser levels: the first non-empty slot has the earliest one of the
+	// level (the current slot is only the first one if it hasn't cascaded yet;
+	// otherwise it can only hold the farthest timers)
+	for (unsigned l = 1; l < LEVELS; ++l)
+	{
+		if (!m_levelCount[l]) continue;
+		auto pos = (std::size_t)(m_current >> shift(l));
+		std::size_t first = (m_current & ((Tick(1) << shift(l)) - 1)) ? 1 : 0;
+		for (std::size_t i = first; i < first + LN_SIZE; ++i)
+		{
+			auto index = m_slots[l][(pos + i) & LN_MASK];
+			if (index == -1) continue;
+			for (; index != -1; index = m_timers[index].next)
+				result = result ? min(*result, m_timers[index].due) : m_timers[index].due;
+			break;
+		}
+	}
+
+	return result;
+}
+
+
+//----------------------------------------------------------------------------
+void TimerWheel::link(std::uint32_t index)
+{
+	auto& t = m_timers[index];
+
+	// Anything overdue is due right away (or, while advancing, at the next tick,
+	// so that callbacks starting new timers can't keep the current tick busy)
+	t.due = max(t.due, m_firing == -1 ? m_current : m_current + 1);
+
+	auto delta = t.due - m_current;
+	if (delta < L0_SIZE)
+	{
+		t.level = 0;
+		t.slot = (std::uint16_t)(t.due & L0_MASK);
+	}
+	else
+	{
+		// Park it in the last level if it's too far away (it will be re-linked
+		// when that slot cascades, and so on, until it gets close enough)
+		Tick due = delta < MAX_SPAN ? t.due : m_current + MAX_SPAN - 1;
+		unsigned l = 1;
+		while (l < LEVELS - 1 && delta >= (Tick(1) << shift(l + 1))) ++l;
+		t.level = (std::uint8_t)l;
+		t.slot = (std::uint16_t)((due >> shift(l)) & LN_MASK);
+	}
+
+	auto& head = m_slots[t.level][t.slot];
+	t.prev = -1;
+	t.next = head;
+	if (head != -1) m_timers[head].prev = (std::int32_t)index;
+	head = (std::int32_t)index;
+	++m_levelCount[t.level];
+}
+
+
+void TimerWheel::unlink(std::uint32_t index)
+{
+	auto& t = m_timers[index];
+	if (t.prev != -1) m_timers[t.prev].next = t.next;
+	else              m_slots[t.level][t.slot] = t.next;
+	if (t.next != -1) m_timers[t.next].prev = t.prev;
+	t.prev = t.next = -1;
+	assert(m_levelCount[t.level]);
+	--m_levelCount[t.level];
+}
+
+
+void TimerWheel::release(std::uint32_t index)
+{
+	auto& t = m_timers[index];
+	t.callback = nullptr;
+	t.active = false;
+	if (!++t.generation) t.generation = 1; // Keep 0 for the null ID
+	m_free.push_back(index);
+	--m_count;
+}
+
+
+void TimerWheel::cascade(unsigned level, std::size_t slot)
+{
+	auto index = m_slots[level][slot];
+	m_slots[level][slot] = -1;
+	while (index != -1)
+	{
+		auto next = m_timers[index].next;
+		--m_levelCount[level];
+		link((std::uint32_t)index);
+		index = next;
+	}
+}
+
+
+void TimerWheel::fire(std::uint32_t index)
+{
+	// The callback may start new timers, reallocating m_timers, so it must
+	// be moved out (and `t` re-fetched) for the call
+	auto callback = move(m_timers[index].callback);
+	if (!m_timers[index].period) m_timers[index].active = false; // Done (stop() is a no-op now)
+
+	m_firing = (std::int32_t)index;
+	bool keep = callback();
+	m_firing = -1;
+
+	auto& t = m_timers[index];
+	if (t.active && keep) // Periodic, and not stopped
+	{
+		t.callback = move(callback);
+		// Skip the periods missed (e.g. while the app was busy), but stay
+		// in phase
+		t.due += t.period;
+		if (t.due <= m_current)
+			t.due += (m_current - t.due) / t.period * t.period + t.period;
+		link(index);
+	}
+	else
+	{
+		release(index);
+	}
+}
+
+} // namespace
@@ -1,11 +1,15 @@
 #include "sfw/Widget.hpp"
 #include "sfw/WidgetContainer.hpp"
+#include "sfw/Layout.hpp"
 #include "sfw/GUI-main.hpp"
 #include "sfw/Widgets/Tooltip.hpp"
 #include "sfw/util/diagnostics.hpp"
+#include "sfw/util/pool.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 #ifdef DEBUG
 #
@@ -30,6 +34,15 @@ using enum ActivationState;
 	return Main->recall(name);
 }
 
+/*static*/ Widget* Widget::getWidget_proxy(const internal::HashedName& name, const Widget* w/* = nullptr*/)
+{
+	assert(GUI::DefaultInstance);
+	auto Main = w ? w->getMain() : GUI::DefaultInstance;
+
+	assert(Main);
+	return Main->recall(name);
+}
+
 /*!!Obsolete since #322:
 Widget* Widget::getWidget(const std::string& name) const
 {
@@ -55,13 +68,12 @@ Widget::Widget() :
 Widget::Widget(Widget&& tmp) :
 	Event::Handler(tmp),
 	m_parent(tmp.m_parent),
-	m_previous(tmp.m_previous),
-	m_next(tmp.m_next),
+	m_index(tmp.m_index),
+	m_isContainer(tmp.m_isContainer),
 	m_focusable(tmp.m_focusable),
 	m_activationState(tmp.m_activationState),
 	m_position(tmp.m_position),
-	m_size(tmp.m_size),
-	m_transform(tmp.m_transform)
+	m_size(tmp.m_size)
 {
 //cerr << "Moving " << &tmp << " to " << this << endl;
 	if (tmp.m_tooltip)
@@ -70,18 +82,20 @@ Widget::Widget(Widget&& tmp) :
 		//!! So, this is a broader error class than this, actually...
 	}
 	else m_tooltip = nullptr;
+
+	// Keep the tick subscription, too (e.g. of a bound widget, when added to the GUI as a copy)
+	if (tmp.m_ticking) requestTicks(true, tmp.m_tickInterval);
 }
 
 Widget::Widget(const Widget& other) :
 	Event::Handler(other),
 	m_parent(other.m_parent),
-	m_previous(other.m_previous),
-	m_next(other.m_next),
+	m_index(other.m_index),
+	m_isContainer(other.m_isContainer),
 	m_focusable(other.m_focusable),
 	m_activationState(other.m_activationState),
 	m_position(other.m_position),
-	m_size(other.m_size),
-	m_transform(other.m_transform)
+	m_size(other.m_size)
 {
 //cerr << "Copying " << &other << " to " << this << endl;
 	if (other.m_tooltip)
@@ -90,11 +104,205 @@ Widget::Widget(const Widget& other) :
 		//!! So, this is a broader error class than this, actually...
 	}
 	else m_tooltip = nullptr;
+
+	// Keep the tick subscription, too (e.g. of a bound widget, when added to the GUI as a copy)
+	if (other.m_ticking) requestTicks(true, other.m_tickInterval);
 }
 
 Widget::~Widget()
 {
 	if (m_tooltip) delete m_tooltip;
+
+	release_handle_slot();
+}
+
+
+//----------------------------------------------------------------------------
+#ifndef SFW_NO_WIDGET_POOL
+namespace {
+	// Never destroyed, as widgets may outlive any static object (e.g. if owned
+	// by another static object)
+	util::SizeClassPool& widget_pool() { static auto* pool = new util::SizeClassPool; return *pool; }
+}
+
+void* Widget::operator new(std::size_t size)
+{
+	return widget_pool().allocate(size);
+}
+
+void* Widget::operator new(std::size_t size, std::align_val_t align)
+{
+	if ((std::size_t)align <= util::SizeClassPool::GRANULARITY)
+		return widget_pool().allocate(size);
+	return ::operator new(size, align);
+}
+
+void Widget::operator delete(void* p, std::size_t size) noexcept
+{
+	widget_pool().deallocate(p, size);
+}
+
+void Widget::operator delete(void* p, std::size_t size, std::align_val_t align) noexcept
+{
+	if ((std::size_t)align <= util::SizeClassPool::GRANULARITY)
+		widget_pool().deallocate(p, size);
+	else
+		::operator delete(p, size, align);
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Generational handles
+//
+// The slot table is shared by all GUIs. Freed slots are reused, but with
+// their generation bumped, so any stale handles to them won't resolve.
+//
+namespace {
+	struct HandleSlot
+	{
+		Widget* widget;
+		std::uint32_t generation;
+	};
+	// (Function-local statics, to be safe from init. order issues with
+	// static widgets.)
+	std::vector<HandleSlot>& handle_slots() { static std::vector<HandleSlot> slots; return slots; }
+	std::vector<std::uint32_t>& free_handle_slots() { static std::vector<std::uint32_t> free; return free; }
+}
+
+Widget::HandleId Widget::getHandleId() const
+{
+	auto& slots = handle_slots();
+	if (!m_handleSlot)
+	{
+		std::uint32_t slot;
+		if (auto& free = free_handle_slots(); !free.empty())
+		{
+			slot = free.back();
+			free.pop_back();
+			slots[slot].widget = const_cast<Widget*>(this);
+		}
+		else
+		{
+			slot = (std::uint32_t)slots.size();
+			slots.push_back({const_cast<Widget*>(this), 1});
+		}
+		m_handleSlot = slot + 1;
+	}
+	return {m_handleSlot - 1, slots[m_handleSlot - 1].generation};
+}
+
+/*static*/ Widget* Widget::fromHandleId(HandleId id)
+{
+	auto& slots = handle_slots();
+	return id.slot < slots.size() && slots[id.slot].generation == id.generation
+		? slots[id.slot].widget : nullptr;
+}
+
+void Widget::release_handle_slot()
+{
+	if (!m_handleSlot)
+		return;
+
+	auto& slot = handle_slots()[m_handleSlot - 1];
+	slot.widget = nullptr;
+	if (++slot.generation == 0) slot.generation = 1; // 0 is for null handles
+	free_handle_slots().push_back(m_handleSlot - 1);
+	m_handleSlot = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Per-frame tick subscriptions
+//
+// Shared by all GUIs, like the handle table (each GUI only ticks its own
+// widgets). Unsubscribing just clears the flag; the entry is dropped by the
+// next tick (so subscribers can come and go even during ticking).
+//
+// The ones with an interval are only listed until their first tick in a
+// GUI, which then starts a (widget-bound) timer for them instead.
+//
+namespace {
+	std::vector<Widget::HandleId>& tick_list() { static std::vector<Widget::HandleId> list; return list; }
+
+	void list_for_ticks(Widget::HandleId id)
+	{
+		auto& list = tick_list();
+		// It may still be listed, if it has just unsubscribed
+		if (std::ranges::find_if(list, [id](auto& h) { return h.slot == id.slot && h.generation == id.generation; }) == list.end())
+			list.push_back(id);
+	}
+}
+
+void Widget::requestTicks(bool enable, float interval)
+{
+	if (enable == m_ticking && (!enable || interval == m_tickInterval))
+		return;
+
+	if (m_tickTimer)
+	{
+		if (auto* main = getMain(); main) main->stopTimer(m_tickTimer);
+		m_tickTimer = {};
+	}
+
+	m_ticking = enable;
+	m_tickInterval = interval > 0 ? interval : 0;
+	if (enable)
+		list_for_ticks(getHandleId());
+}
+
+void Widget::rearm_ticks()
+{
+	if (!m_tickTimer)
+		return;
+
+	if (auto* main = getMain(); main) main->stopTimer(m_tickTimer);
+	m_tickTimer = {};
+	list_for_ticks(getHandleId());
+}
+
+/*static*/ void Widget::tick_subscribers(GUI* main)
+{
+	auto& list = tick_list();
+	bool stale = false;
+	for (size_t i = 0; i < list.size(); ++i) // Not a range-for: may be appended to meanwhile
+	{
+		auto* w = fromHandleId(list[i]);
+		if (!w || !w->m_ticking || w->m_tickTimer) { stale = true; continue; }
+		if (w->getMain() != main) continue;
+
+		if (w->m_tickInterval > 0)
+		{
+			// Switch to a timer (which stops itself if the widget is gone)
+			w->m_tickTimer = main->startTimer(w->m_tickInterval, [w] { w->onTick(); }, w->m_tickInterval, w);
+			stale = true;
+		}
+		w->onTick();
+	}
+
+	if (stale) std::erase_if(list, [](auto& h) {
+		auto* w = fromHandleId(h);
+		return !w || !w->m_ticking || w->m_tickTimer;
+	});
+}
+
+/*static*/ bool Widget::ticks_requested(const GUI* main)
+{
+	return std::ranges::any_of(tick_list(), [main](auto& h) {
+		auto* w = fromHandleId(h);
+		return w && w->m_ticking && !w->m_tickTimer && w->getMain() == main;
+	});
+}
+
+
+//----------------------------------------------------------------------------
+/*static*/ bool Widget::offer_wheel(Widget* widget, int delta)
+{
+	s_wheelDeclined = false;
+	widget->onMouseWheelMoved(delta);
+	bool taken = !s_wheelDeclined;
+	s_wheelDeclined = false;
+	return taken;
 }
 
 
@@ -124,8 +332,42 @@ GUI* Widget::getMain() const
 {
 	//!! Well, it's halfway between "undefined" and "bug" to call this on free-standing widgets...
 	//!! But forbidding it would prevent adding children to them, criplling usability too much!
-	//!!   assert(getParent() && getParent() != this ? getParent()->getRoot() : getParent());
-	return (GUI*)(getParent() && getParent() != this ? getParent()->getRoot() : getParent());
+	//!! (It just returns null for them.)
+	if (!m_placementCached) update_cached_placement();
+	return m_main;
+}
+
+
+//----------------------------------------------------------------------------
+void Widget::update_cached_placement() const
+{
+	if (isRoot())
+	{
+		m_absPosition = m_position;
+		//! Not just any root: a free-standing subtree has no GUI yet!
+		m_main = isMain() ? (GUI*)const_cast<Widget*>(this) : nullptr;
+	}
+	else
+	{
+		const Widget* parent = getParent();
+		if (!parent->m_placementCached) parent->update_cached_placement();
+		m_absPosition = parent->m_absPosition + m_position;
+		m_main = parent->m_main;
+	}
+	m_placementCached = true;
+}
+
+void Widget::reset_cached_placement()
+{
+	if (!m_placementCached) // Then neither is any of the descendants' (see the invariant)
+		return;
+
+	m_placementCached = false;
+	if (Layout* container = toLayout(); container)
+	{
+		for (Widget* w : *container)
+			w->reset_cached_placement();
+	}
 }
 
 
@@ -151,16 +393,19 @@ std::string Widget::getName(Widget* widget) const
 //----------------------------------------------------------------------------
 Widget* Widget::setPosition(const sf::Vector2f& pos)
 {
-	m_position = {roundf(pos.x), roundf(pos.y)};
-	m_transform = sf::Transform(
-		1, 0, m_position.x, // translate x
-		0, 1, m_position.y, // translate y
-		0, 0, 1
-	);
-
+	set_position(pos);
+	invalidate();
 	return this;
 }
 
+void Widget::set_position(const sf::Vector2f& pos)
+{
+	sf::Vector2f new_pos = {roundf(pos.x), roundf(pos.y)};
+	if (new_pos != m_position) reset_cached_placement();
+
+	m_position = new_pos;
+}
+
 Widget* Widget::setPosition(float x, float y)
 {
 	setPosition(sf::Vector2f(x, y));
@@ -181,16 +426,8 @@ const sf::Vector2f& Widget::getPosition() const
 
 sf::Vector2f Widget::getAbsolutePosition() const
 {
-	sf::Vector2f position = m_position;
-
-	for (const Widget* base = this; !base->isRoot();)
-	{
-		base = base->getParent();
-		position.x += base->m_position.x;
-		position.y += base->m_position.y;
-	}
-
-	return position;
+	if (!m_placementCached) update_cached_placement();
+	return m_absPosition;
 }
 
 
@@ -201,8 +438,9 @@ Widget* Widget::setSize(const sf::Vector2f& size)
 	if (m_size.x != new_size.x || m_size.y != new_size.y)
 	{
 		m_size = new_size;
+		invalidate();
 		onResized();
-		if (!isRoot()) getParent()->recomputeGeometry();
+		if (!isRoot()) getParent()->invalidateGeometry(); // Deferred to the next layout pass
 	}
 	return this;
 }
@@ -283,12 +521,14 @@ Widget* Widget::enable(bool state)
 		if (m_activationState == Disabled)
 		{
 			m_activationState = Default;
+			invalidate();
 			onActivationChanged(m_activationState);
 		}
 	} else {
 		if (m_activationState != Disabled)
 		{
 			m_activationState = Disabled;
+			invalidate();
 			onActivationChanged(m_activationState);
 		}
 	}
@@ -305,6 +545,7 @@ bool Widget::enabled() const
 void Widget::setParent(WidgetContainer* parent)
 {
 	m_parent = parent;
+	reset_cached_placement();
 }
 
 
@@ -327,6 +568,7 @@ Widget* Widget::setTooltip(const std::string& text)
 //----------------------------------------------------------------------------
 void Widget::setActivationState(ActivationState state)
 {
+	if (state != m_activationState) invalidate();
 	m_activationState = state;
 	onActivationChanged(state);
 }
@@ -339,9 +581,14 @@ ActivationState Widget::getActivationState() const
 
 
 //----------------------------------------------------------------------------
-const sf::Transform& Widget::getTransform() const
-{
-	return m_transform;
+void Widget::invalidate()
+{
+	m_dirty = true;
+	// Roll it up to the GUI -- but only until an already dirty ancestor, as
+	// then the rest of the chain must be dirty, too. (The GUI itself is its
+	// own parent, so this will also stop there.)
+	for (Widget* w = m_parent; w && !w->m_dirty; w = w->m_parent)
+		w->m_dirty = true;
 }
 
 
@@ -355,6 +602,7 @@ void Widget::draw_outline(const gfx::RenderContext& ctx, sf::Color outlinecolor,
 	r.setFillColor(fillcolor);
 	r.setOutlineThickness(2);
 	r.setOutlineColor(outlinecolor);
+	if (ctx.renderer) ctx.renderer->flush(); // `r` is temporary, so it can't be queued; draw it right away then
 	ctx.target.draw(r);
 }
 #endif
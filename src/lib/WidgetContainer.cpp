@@ -1,6 +1,8 @@
 #include "sfw/WidgetContainer.hpp"
 
 #include "sfw/GUI-main.hpp"
+#include "sfw/Layout.hpp"
+#include "sfw/Widgets/Tooltip.hpp"
 #include "sfw/util/shim/sfml.hpp"
 
 #include <cassert>
@@ -9,56 +11,49 @@
 #include <charconv>
     using std::to_chars;
 #include <utility>
-#ifdef DEBUG
 #include <iostream>
-#endif
+    using std::cerr;
 
 namespace sfw
 {
 
-WidgetContainer::WidgetContainer():
-	m_first(nullptr),
-	m_last(nullptr)
+WidgetContainer::WidgetContainer()
 {
+	m_isContainer = true;
 }
 
 
 WidgetContainer::~WidgetContainer()
 {
 	// Deallocate all widgets
-	const Widget* widget = m_first;
-	while (widget != nullptr)
-	{
-		const Widget* next = widget->m_next;
+	for (Widget* widget : m_children)
 		delete widget;
-		widget = next;
-	}
 }
 
 //----------------------------------------------------------------------------
-//!!Replace this with an std-compliant interface + std::operations! (#162)
-//!!And also provide (template?) variants for different f types!
+//! Indexing (instead of iterators), so that `f` can also add new children
+//! (which might reallocate the array)
 void WidgetContainer::foreach(const std::function<void(Widget*)>& f)
 {
-	for (Widget* w = m_first; w; w = w->m_next)
-		f(w);
+	for (size_t i = 0; i < m_children.size(); ++i)
+		f(m_children[i]);
 }
 void WidgetContainer::cforeach(const std::function<void(const Widget*)>& f) const
 {
-	for (const Widget* w = m_first; w; w = w->m_next)
-		f(w);
+	for (size_t i = 0; i < m_children.size(); ++i)
+		f(m_children[i]);
 }
 
 bool WidgetContainer::foreachb(const std::function<bool(Widget*)>& f)
 {
-	for (Widget* w = m_first; w; w = w->m_next)
-		if (!f(w)) return false;
+	for (size_t i = 0; i < m_children.size(); ++i)
+		if (!f(m_children[i])) return false;
 	return true;
 }
 bool WidgetContainer::cforeachb(const std::function<bool(const Widget*)>& f) const
 {
-	for (const Widget* w = m_first; w; w = w->m_next)
-		if (!f(w)) return false;
+	for (size_t i = 0; i < m_children.size(); ++i)
+		if (!f(m_children[i])) return false;
 	return true;
 }
 
@@ -68,7 +63,7 @@ void WidgetContainer::traverse(const std::function<void(Widget*)>& f)
 {
 	foreach([&](auto* w) {
 		f(w);
-		w->traverse(f);
+		w->traverse(f); // Virtual, to also support compound widgets
 	});
 }
 void WidgetContainer::ctraverse(const std::function<void(const Widget*)>& f) const
@@ -81,99 +76,218 @@ void WidgetContainer::ctraverse(const std::function<void(const Widget*)>& f) con
 
 
 //----------------------------------------------------------------------------
-bool WidgetContainer::is_child(const Widget* widget)
+void WidgetContainer::invalidateGeometry()
+{
+	m_geometryDirty = true;
+
+	// Make sure the layout pass will find us (like invalidate(), this can
+	// stop at the first ancestor already marked)
+	for (const Widget* w = this; !w->isRoot();)
+	{
+		auto* parent = w->getParent();
+		if (parent->m_layoutPending) break;
+		parent->m_layoutPending = true;
+		w = parent;
+	}
+}
+
+
+void WidgetContainer::updateLayout()
 {
-	for (Widget* w = begin(); w != end(); w = next(w))
+	// Children first, as their size may affect ours
+	if (m_layoutPending)
+	{
+		foreach([](Widget* w) {
+			if (WidgetContainer* container = w->toLayout(); container)
+				container->updateLayout();
+		});
+		//! Cleared only now, so that the children resizing while being
+		//! rearranged above won't mark the ancestors pending again:
+		m_layoutPending = false;
+	}
+
+	if (m_geometryDirty)
 	{
-		if (w == widget) return true;
+		m_geometryDirty = false;
+		recomputeGeometry(); // May in turn mark the parent dirty, if our size changes
 	}
-	return false;
 }
 
 
 //----------------------------------------------------------------------------
-Widget* WidgetContainer::insert_after(Widget* anchor, Widget* widget, const std::string& name)
-// This is the common workhorse procedure for all the other various add() methods.
+void WidgetContainer::link_after(Widget* anchor, Widget* widget)
 // Does not check if anchor is in fact a local child!
 {
 	assert(widget);
 	// Only freestanding widgets are to be attached:
 	assert(widget->m_parent == nullptr && "Don't copy an already added widget!");
-	assert(widget->m_next == nullptr);
-	assert(widget->m_previous == nullptr);
+	assert(!anchor || anchor->m_parent == this);
 
 	widget->setParent(this); // So far so good... ;)
 
-	if (empty())
+	// Even unnamed widgets can be looked up (by their default names), so
+	// the cached lookups must know about them, too:
+	++internal::name_registry_generation;
+
+	// A container built (or detached) freestanding may still be pending
+	// layout, which its new ancestors don't know about yet:
+	if (auto* container = widget->toLayout();
+	    container && (container->m_geometryDirty || container->m_layoutPending))
+		container->invalidateGeometry();
+
+	auto pos = anchor ? anchor->m_index + 1 : 0;
+	if (pos == m_children.size()) // append (normal `add()`)
+	{
+		widget->m_index = pos;
+		m_children.push_back(widget);
+	}
+	else
+	{
+		m_children.insert(m_children.begin() + (std::ptrdiff_t)pos, widget);
+		reindex_from(pos);
+	}
+}
+
+
+void WidgetContainer::reindex_from(size_t pos)
+{
+	for (auto i = pos; i < m_children.size(); ++i)
+		m_children[i]->m_index = i;
+}
+
+
+Widget* WidgetContainer::insert_after(Widget* anchor, Widget* widget, const std::string& name)
+// This is the common workhorse procedure for all the other various add() methods.
+// Does not check if anchor is in fact a local child!
+{
+	link_after(anchor, widget);
+
+	// Register the widget globally, too (unless unnamed: then it only has an
+	// implicit default name)
+	if (GUI* Main = getMain(); Main && !name.empty())
 	{
-		m_first = m_last = widget;
+		Main->remember(widget, name);
 	}
-	else if (anchor == nullptr) // add as first
+
+	// Get it drawn (it's dirty already, but its new ancestors may not be)
+	widget->invalidate();
+
+	// Adjust the layout (later, in the next layout pass)
+	invalidateGeometry();
+
+	return widget;
+}
+
+
+Widget* WidgetContainer::add(Widget* widget, const std::string& name)
+{
+	return insert_after(last(), widget, name);
+}
+
+
+//----------------------------------------------------------------------------
+GUI* WidgetContainer::reserve_names(size_t count)
+{
+	GUI* Main = getMain();
+	if (Main)
 	{
-		// Just verifying !empty:
-		assert(m_first);
-		assert(m_last);
-		// First is healthy?
-		assert(m_first->m_previous == nullptr);
-		assert(m_first->m_next);
-
-		widget->m_next = m_first;
-		m_first->m_previous = widget;
+		Main->widgets.reserve(Main->widgets.size() + count);
+		Main->m_widgetNames.reserve(Main->m_widgetNames.size() + count);
 	}
-	else if (anchor == m_last) // append (normal `add()`)
+	return Main;
+}
+
+WidgetContainer* WidgetContainer::addMany(std::span<Widget* const> widgets)
+{
+	if (widgets.empty()) return this;
+
+	m_children.reserve(m_children.size() + widgets.size());
+	// (Unnamed widgets don't need registering.)
+	for (Widget* widget : widgets)
 	{
-		assert(anchor); // In case I'd feel like reshuffling the code... ;)
-		// Just verifying !empty:
-		assert(m_last);
-		assert(m_first);
-		// Last is healthy?
-		//assert(m_last->m_previous); <-- anchor *can* also be the first!
-		assert(m_last->m_next == nullptr);
-
-		m_last->m_next = widget;
-		widget->m_previous = m_last;
-
-		m_last = widget;
+		link_after(last(), widget);
+		widget->invalidate(); // Only the first one has to climb up the tree
 	}
-	else // So, we have both a previous and a next one to deal with,
-	{    // but at least don't have to update this->first/last!...
-		// In case I'd feel like reshuffling the code...:
-		assert(anchor);
-		assert(anchor != m_last);
-		// Just verifying !empty:
-		assert(m_last);
-		assert(m_first);
-		// Neighbors...?
-		//assert (anchor->m_previous); <-- anchor *can* be the first!
-		assert(anchor->m_next);
-
-		widget->m_previous = anchor;
-		widget->m_next = anchor->m_next;
-
-		anchor->m_next = widget;
-		widget->m_next->m_previous = widget;
+	invalidateGeometry(); // Once for the whole batch
+	return this;
+}
+
+WidgetContainer* WidgetContainer::addMany(std::span<const std::pair<Widget*, std::string>> named_widgets)
+{
+	if (named_widgets.empty()) return this;
+
+	GUI* Main = reserve_names(named_widgets.size()); //! Also saves looking it up for each widget
+	m_children.reserve(m_children.size() + named_widgets.size());
+	for (const auto& [widget, name] : named_widgets)
+	{
+		link_after(last(), widget);
+		if (Main && !name.empty()) Main->remember(widget, name);
+		widget->invalidate();
 	}
+	invalidateGeometry();
+	return this;
+}
 
 
-	// Register the widget globally, too
-	if (GUI* Main = getMain(); Main)
+//----------------------------------------------------------------------------
+Widget* WidgetContainer::detach(Widget* widget)
+{
+	if (!is_child(widget))
 	{
-		Main->remember(widget, name); // Will assign default if name.empty()!
+		cerr << "- Warning: [sfw::WidgetContainer::detach] Not a child widget: " << widget << "\n";
+		return nullptr;
 	}
 
-	// Adjust the layout
-	recomputeGeometry();
+	forget_child(widget);
+
+	// Cached lookups may point to it (or its descendants), even if unnamed
+	// (by their default names), so must be redone:
+	++internal::name_registry_generation;
+
+	// Clean up the whole subtree from the GUI
+	GUI* Main = getMain();
+	auto cleanup = [Main](Widget* w) {
+		if (w->m_tooltip) w->m_tooltip->cancel();
+		w->rearm_ticks(); // Its tick timer (if any) is in the GUI it's leaving
+		if (Main) Main->forget(w);
+	};
+	cleanup(widget);
+	widget->traverse(cleanup);
+
+	// Unlink
+	auto pos = widget->m_index;
+	assert(pos < m_children.size() && m_children[pos] == widget);
+	m_children.erase(m_children.begin() + (std::ptrdiff_t)pos);
+	reindex_from(pos);
+	widget->m_index = 0;
+	widget->setParent(nullptr);
+
+	// Get the now empty area redrawn, and the rest rearranged
+	invalidate();
+	invalidateGeometry();
 
 	return widget;
 }
 
 
-Widget* WidgetContainer::add(Widget* widget, const std::string& name)
+bool WidgetContainer::remove(Widget* widget)
 {
-	return insert_after(m_last, widget, name);
+	GUI* Main = getMain();
+	if (!detach(widget))
+		return false;
+
+	// If it's (directly or not) an event handler removing it, the widget (or
+	// its subtree) may still be in the middle of the dispatch, so only delete
+	// it after that (it's detached and forgotten already, anyway)
+	if (Main && Main->m_dispatching)
+		Main->m_removedWidgets.push_back(widget);
+	else
+		delete widget;
+	return true;
 }
 
 
+//----------------------------------------------------------------------------
 Widget* WidgetContainer::addAfter(Widget* anchor, Widget* widget, const std::string& name)
 {
 	if (anchor == nullptr)
@@ -206,7 +320,7 @@ Widget* WidgetContainer::addBefore(Widget* anchor, Widget* widget, const std::st
 	else if (is_child(anchor))
 	{
 		// link before anchor
-		return insert_after(anchor->m_previous, widget, name);
+		return insert_after(prev(anchor), widget, name);
 	}
 	else return add(widget, name);
 }
@@ -30,6 +30,7 @@ Button::Button(const std::string& text, std::function<void(Button*)> callback):
 Button* Button::setText(const std::string& text)
 {
 	m_box.item().setString(/*sfw::*/stdstring_to_SFMLString(text));
+	invalidate(); // Even if the size remains the same
 	recomputeGeometry();
 	return this;
 }
@@ -43,6 +44,7 @@ std::string Button::getText() const
 Button* Button::setColor(sf::Color c)
 {
 	m_box.setTintColor(c);
+	invalidate();
 	return this;
 }
 
@@ -50,6 +52,7 @@ Button* Button::setColor(sf::Color c)
 Button* Button::setTextColor(sf::Color c)
 {
 	m_box.setItemColor(c);
+	invalidate();
 	return this;
 }
 
@@ -90,7 +93,7 @@ void Button::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	ctx.target.draw(m_box, sfml_renderstates);
+	ctx.draw(m_box, sfml_renderstates);
 }
 
 // Callbacks -------------------------------------------------------------------
@@ -44,9 +44,9 @@ void CheckBox::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	ctx.target.draw(m_box, sfml_renderstates);
+	ctx.draw(m_box, sfml_renderstates);
 	if (checked())
-		ctx.target.draw(m_checkmark, sfml_renderstates);
+		ctx.draw(m_checkmark, sfml_renderstates);
 }
 
 
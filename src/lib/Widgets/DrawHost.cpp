@@ -15,13 +15,22 @@ DrawHost::DrawHost(const DrawHook& hook)
 Widget* DrawHost::setDrawHook(const DrawHook& hook)
 {
     m_drawHook = hook;
+    invalidate();
     return this;
 }
 
 
 void DrawHost::draw(const gfx::RenderContext& ctx) const
 {
-    m_drawHook(const_cast<DrawHost*>(this), ctx);
+    // The hook may draw anything, anywhere (and with any temporary objects),
+    // so everything queued so far must be out already, to keep the Z-order,
+    // and the hook itself should just draw directly to the target:
+    if (ctx.renderer) ctx.renderer->flush();
+    // (It may also draw to the target directly, bypassing ctx.draw(), so the
+    // clipping is set up for the whole call, not just for each ctx.draw().)
+    if (ctx.clip) gfx::applyClipRect(ctx.target, ctx.clip);
+    m_drawHook(const_cast<DrawHost*>(this), gfx::RenderContext{ctx.target, ctx.props});
+    if (ctx.clip) gfx::applyClipRect(ctx.target, std::nullopt);
 }
 
 } // namespace
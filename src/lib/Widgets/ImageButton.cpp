@@ -31,6 +31,7 @@ ImageButton* ImageButton::setTexture(const sf::Texture& texture)
 	m_background.setTextureRect(sf::IntRect({0, 0}, {width, height}));
 
 	Widget::setSize((float)width, (float)height);
+	invalidate();
 	return this;
 }
 
@@ -94,6 +95,7 @@ ImageButton* ImageButton::setTextSize(size_t size)
 ImageButton* ImageButton::setTextStyle(sf::Text::Style style)
 {
 	m_text.setStyle(style);
+	invalidate();
 	return this;
 }
 
@@ -101,6 +103,7 @@ ImageButton* ImageButton::setTextStyle(sf::Text::Style style)
 ImageButton* ImageButton::setTextColor(sf::Color color)
 {
 	m_text.setFillColor(color);
+	invalidate();
 	return this;
 }
 
@@ -109,9 +112,9 @@ void ImageButton::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	ctx.target.draw(m_background, sfml_renderstates);
+	ctx.draw(m_background, sfml_renderstates);
 	sfml_renderstates.transform *= m_background.getTransform(); // Follow the scaling (etc.) of the image!
-	ctx.target.draw(m_text, sfml_renderstates);
+	ctx.draw(m_text, sfml_renderstates);
 }
 
 
@@ -192,6 +195,7 @@ void ImageButton::press()
 	{
 		m_pressed = true;
 		m_text.move({0, 1});
+		invalidate();
 	}
 }
 
@@ -201,6 +205,7 @@ void ImageButton::release()
 	{
 		m_pressed = false;
 		m_text.move({0, -1});
+		invalidate();
 	}
 }
 
@@ -211,6 +216,7 @@ void ImageButton::centerText()
 	sf::FloatRect t = m_text.getLocalBounds();
 	m_text.setOrigin({t.left + round(t.width / 2.f), t.top + round(t.height / 2.f)});
 	m_text.setPosition({boxwidth / 2, boxheight / 2});
+	invalidate();
 }
 
 } // namespace
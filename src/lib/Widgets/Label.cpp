@@ -1,5 +1,6 @@
 #include "sfw/Widgets/Label.hpp"
 #include "sfw/Theme.hpp"
+#include "sfw/GUI-main.hpp"
 #include "sfw/util/shim/sfml.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
@@ -18,6 +19,7 @@ Label::Label(const std::string& text)
 Label* Label::setText(const std::string& text)
 {
     m_text.setString(/*sfw::*/stdstring_to_SFMLString(text));
+    invalidate(); // Even if the size remains the same
     recomputeGeometry();
     return this;
 }
@@ -28,9 +30,31 @@ std::string Label::getText() const
 }
 
 
+Label* Label::unbind()
+{
+    m_sampler = nullptr;
+    requestTicks(false);
+    return this;
+}
+
+void Label::start_sampling()
+{
+    m_channelVersion = 0;
+    requestTicks(true, GUI::FRAME_INTERVAL);
+}
+
+void Label::onTick()
+{
+    if (m_sampler)
+        if (auto text = m_sampler(m_channelVersion); text)
+            setText(*text);
+}
+
+
 Label* Label::setFillColor(const sf::Color& color)
 {
     m_text.setFillColor(color);
+    invalidate();
     return this;
 }
 
@@ -56,6 +80,7 @@ size_t Label::getTextSize() const
 Label* Label::setStyle(sf::Text::Style style)
 {
     m_text.setStyle(style);
+    invalidate();
     return this;
 }
 
@@ -64,7 +89,7 @@ void Label::draw(const gfx::RenderContext& ctx) const
 {
     auto sfml_renderstates = ctx.props;
     sfml_renderstates.transform *= getTransform();
-    ctx.target.draw(m_text, sfml_renderstates);
+    ctx.draw(m_text, sfml_renderstates);
 }
 
 
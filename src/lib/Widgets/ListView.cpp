@@ -0,0 +1,269 @@
+#include "sfw/Widgets/ListView.hpp"
+#include "sfw/Theme.hpp"
+
+#include <algorithm>
+	using std::min, std::max;
+#include <utility>
+	using std::move;
+#include <iostream>
+	using std::cerr;
+
+namespace sfw
+{
+
+ListView::ListView(float width, size_t visibleRows, ItemCount count, RowFactory makeRow, RowBinder bindRow):
+	m_count(move(count)),
+	m_makeRow(move(makeRow)),
+	m_bindRow(move(bindRow)),
+	m_width(width),
+	m_visibleRows(max(visibleRows, (size_t)1))
+{
+	// The rows will only be created by the first layout pass (or refresh());
+	// see ensure_rows()!
+}
+
+
+//----------------------------------------------------------------------------
+ListView* ListView::refresh()
+{
+	sync_data();
+	invalidateGeometry(); // The rows may have changed size
+	return this;
+}
+
+
+ListView* ListView::scrollTo(size_t item)
+{
+	if (!m_synced) sync_data();
+	bind_rows(item);
+	return this;
+}
+
+ListView* ListView::scroll(long rows)
+{
+	if (!m_synced) sync_data();
+	bind_rows(rows < 0 ? m_top - min(m_top, (size_t)-rows) : m_top + (size_t)rows);
+	return this;
+}
+
+ListView* ListView::ensureVisible(size_t item)
+{
+	if (!m_synced) sync_data();
+	if (item < m_top)                       bind_rows(item);
+	else if (item >= m_top + m_visibleRows) bind_rows(item - m_visibleRows + 1);
+	return this;
+}
+
+
+size_t ListView::itemAt(const Widget* row) const
+{
+	auto n = m_rows.size();
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (m_rows[(m_firstRow + i) % n] == row)
+			return m_top + i < m_itemCount ? m_top + i : npos;
+	}
+	return npos;
+}
+
+
+//----------------------------------------------------------------------------
+void ListView::sync_data()
+{
+	m_itemCount = m_count ? m_count() : 0;
+	m_synced = true;
+	ensure_rows();
+	bind_rows(m_top, true);
+}
+
+
+bool ListView::ensure_rows()
+{
+	auto needed = min(m_visibleRows, m_itemCount);
+	if (m_rows.size() >= needed)
+		return false;
+
+	while (m_rows.size() < needed)
+	{
+		Widget* row = m_makeRow ? m_makeRow() : nullptr;
+		if (!row)
+		{
+			cerr << "- ERROR: [sfw::ListView] Failed to create new row widget!\n";
+			break;
+		}
+		//! Not via add(): that would also register the row by name (which is
+		//! pointless for these anonymous, recycled widgets), and then schedule
+		//! another layout pass, while this may be called during one already.
+		link_after(last(), row);
+		row->invalidate();
+		m_rows.push_back(row);
+	}
+	m_firstRow = 0; // The ring has just been broken up; everything will be rebound anyway
+	return true;
+}
+
+
+void ListView::bind_rows(size_t top, bool rebind_all)
+{
+	// Don't scroll past the end
+	top = min(top, m_itemCount > m_visibleRows ? m_itemCount - m_visibleRows : 0);
+
+	if (top == m_top && !rebind_all)
+		return;
+
+	// Which item has (or should have) the focus?
+	// (If its row is not focused, while in view, then the focus is gone.)
+	if (auto* row = focusedChild(); row)
+		m_focusedItem = itemAt(row);
+	else if (m_focusedItem >= m_top && m_focusedItem < m_top + m_visibleRows)
+		m_focusedItem = npos;
+
+	// Rotate the ring, so that the rows still in view keep their items, and
+	// only the rest (in the [rebind_from, rebind_to) display positions) need
+	// to be rebound
+	auto n = m_rows.size();
+	size_t rebind_from = 0, rebind_to = n;
+	if (!rebind_all && n)
+	{
+		if (top > m_top && top - m_top < n)
+		{
+			auto d = top - m_top;
+			m_firstRow = (m_firstRow + d) % n;
+			rebind_from = n - d;
+		}
+		else if (top < m_top && m_top - top < n)
+		{
+			auto d = m_top - top;
+			m_firstRow = (m_firstRow + n - d) % n;
+			rebind_to = d;
+		}
+	}
+	m_top = top;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		Widget* row = m_rows[(m_firstRow + i) % n];
+		if (m_top + i >= m_itemCount)
+		{
+			// Unbound (spare) row (e.g. after the data shrank); parked by position_rows()
+			row->disable();
+		}
+		else if (i >= rebind_from && i < rebind_to)
+		{
+			row->enable();
+			if (m_bindRow) m_bindRow(row, m_top + i);
+		}
+	}
+
+	// Whatever was hovered has now likely moved away from under the mouse
+	unhover();
+
+	// Move the focus to the row now showing the focused item (if any)
+	if (m_focusedItem != npos)
+	{
+		Widget* row = m_focusedItem >= m_top && m_focusedItem - m_top < min(n, m_itemCount - m_top)
+		            ? m_rows[(m_firstRow + m_focusedItem - m_top) % n] : nullptr;
+		if (focusedChild() != row)
+		{
+			unfocus(); // Its row has been recycled (or parked)
+			if (row) focus(row);
+		}
+	}
+
+	position_rows();
+}
+
+
+void ListView::position_rows()
+{
+	auto n = m_rows.size();
+	for (size_t i = 0; i < n; ++i)
+	{
+		// Spare rows are moved just below the visible area (where draw() clips them)
+		auto pos = m_top + i < m_itemCount ? i : m_visibleRows;
+		m_rows[(m_firstRow + i) % n]->setPosition(0, pos * m_rowHeight);
+	}
+}
+
+
+//----------------------------------------------------------------------------
+void ListView::recomputeGeometry()
+{
+	if (!m_synced) sync_data();
+
+	// The tallest row sets the pace (or the default box height, while no rows)
+	float rowHeight = 0;
+	for (auto* row : m_rows)
+		rowHeight = max(rowHeight, row->getSize().y);
+	m_rowHeight = rowHeight > 0 ? rowHeight : m_rowHeight > 0 ? m_rowHeight : Theme::getBoxHeight();
+
+	position_rows();
+	setSize(m_width, m_rowHeight * m_visibleRows);
+}
+
+
+void ListView::draw(const gfx::RenderContext& ctx) const
+{
+	// Only the visible area, not the spare rows parked below it
+	Layout::draw(ctx.clipped({getPosition(), getSize()}));
+}
+
+
+void ListView::onMouseWheelMoved(int delta)
+{
+	// The row under the mouse has the first pick (e.g. if it's being edited)
+	if (auto* row = hoveredChild(); row && row->enabled() && offer_wheel(row, delta))
+		return;
+
+	// Scroll, or let the outer scrollers have it, if already at the end
+	auto before = m_top;
+	scroll(-delta * 3); //!! Make it configurable...
+	if (m_top == before)
+		decline_wheel();
+}
+
+
+void ListView::onKeyPressed(const sf::Event::KeyEvent& key)
+{
+	// Navigation keys are ours, unless a row has the focus
+	if (!focused())
+	{
+		switch (key.code)
+		{
+		case sf::Keyboard::Key::Up:       scroll(-1); return;
+		case sf::Keyboard::Key::Down:     scroll(1);  return;
+		case sf::Keyboard::Key::PageUp:   scroll(-(long)m_visibleRows); return;
+		case sf::Keyboard::Key::PageDown: scroll((long)m_visibleRows);  return;
+		case sf::Keyboard::Key::Home:     scrollTo(0); return;
+		case sf::Keyboard::Key::End:      scrollTo(m_itemCount); return;
+		default:
+			break;
+		}
+	}
+	Layout::onKeyPressed(key);
+}
+
+
+void ListView::onActivationChanged(ActivationState state)
+{
+	// Losing the focus also drops the focused item
+	if (state != ActivationState::Focused)
+		m_focusedItem = npos;
+	Layout::onActivationChanged(state);
+}
+
+
+void ListView::forget_child(Widget* child)
+{
+	Layout::forget_child(child);
+
+	// Drop it from the row pool, too (the ring order is lost, and a row may
+	// be missing now, so everything will be rebuilt by the next layout pass)
+	if (std::erase(m_rows, child))
+	{
+		m_firstRow = 0;
+		m_synced = false;
+	}
+}
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "sfw/Widgets/ProgressBar.hpp"
 #include "sfw/Theme.hpp"
+#include "sfw/GUI-main.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -68,15 +69,32 @@ ProgressBar* ProgressBar::setRange(float min, float max, std::string unit)
 }
 
 
+ProgressBar* ProgressBar::bind(std::shared_ptr<ValueChannel<float>> channel)
+{
+	m_channel = std::move(channel);
+	m_channelVersion = 0;
+	requestTicks(m_channel != nullptr, GUI::FRAME_INTERVAL);
+	return this;
+}
+
+
+void ProgressBar::onTick()
+{
+	// (set() does nothing if the value is the same)
+	if (float value; m_channel && m_channel->load_if_changed(value, m_channelVersion))
+		set(value);
+}
+
+
 void ProgressBar::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	ctx.target.draw(m_box, sfml_renderstates);
+	ctx.draw(m_box, sfml_renderstates);
 	sfml_renderstates.texture = &Theme::getTexture();
-	ctx.target.draw(m_bar, _VERTEX_COUNT_, sf::PrimitiveType::TriangleStrip, sfml_renderstates);
+	ctx.draw(m_bar, _VERTEX_COUNT_, sf::PrimitiveType::TriangleStrip, sfml_renderstates);
 	if (m_cfg.label_placement != LabelNone)
-		ctx.target.draw(m_label, sfml_renderstates);
+		ctx.draw(m_label, sfml_renderstates);
 }
 
 
@@ -195,6 +213,7 @@ void ProgressBar::updateGeometry()
 			m_label.setPosition({labelX, m_box.getSize().y + Theme::PADDING});
 		}
 	}
+	invalidate();
 }
 
 
@@ -273,6 +273,7 @@ void Slider::updateView()
 		m_progression[0].position.y = offset;
 		m_progression[2].position.y = offset;
 	}
+	invalidate();
 }
 
 //----------------------------------------------------------------------------
@@ -371,9 +372,9 @@ void Slider::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	ctx.target.draw(m_track, sfml_renderstates);
-	ctx.target.draw(m_progression, 4, sf::PrimitiveType::TriangleStrip, sfml_renderstates);
-	ctx.target.draw(m_thumb, sfml_renderstates);
+	ctx.draw(m_track, sfml_renderstates);
+	ctx.draw(m_progression, 4, sf::PrimitiveType::TriangleStrip, sfml_renderstates);
+	ctx.draw(m_thumb, sfml_renderstates);
 }
 
 
@@ -428,6 +429,7 @@ void Slider::onMousePressed(float x, float y)
 
 void Slider::onMouseMoved(float x, float y)
 {
+	auto thumbstate = m_thumb.activationState();
 	if (focused())
 	{
 		if (m_thumb_pressed) //!! #182: Not `if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))`
@@ -445,6 +447,8 @@ void Slider::onMouseMoved(float x, float y)
 	{
 		m_thumb.applyState(ActivationState::Default);
 	}
+	if (m_thumb.activationState() != thumbstate)
+		invalidate();
 }
 
 
@@ -463,6 +467,9 @@ void Slider::onMouseReleased(float, float)
 
 void Slider::onMouseWheelMoved(int delta)
 {
+	// Only while focused, so it doesn't hijack the scrolling of the page
+	if (!focused()) return decline_wheel();
+
 	if (m_cfg.invert) delta = -delta;
 	if (delta > 0) inc(); else dec();
 	//!!if (delta > 0) inc(delta * step()); else dec(delta * step());
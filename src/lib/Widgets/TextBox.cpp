@@ -8,7 +8,6 @@
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Text.hpp>
-#include <SFML/OpenGL.hpp>
 
 #include <cassert>
 #include <algorithm>
@@ -103,7 +102,7 @@ TextBox* TextBox::setMaxLength(size_t maxLength)
 TextBox*  TextBox::setPlaceholder(const std::string& placeholder)
 {
 	m_placeholder.set(placeholder);
-
+	invalidate();
 	return this;
 }
 
@@ -284,11 +283,13 @@ void TextBox::set_selection(size_t from, size_t length)
 	m_selection.start(from);
 	m_selection.follow(from + length);
 	m_selection.stop(); // <- May not be desired in all cases! (Add a flag to this fn. as needed then.)
+	invalidate();
 }
 
 void TextBox::clear_selection()
 {
 	m_selection.cancel();  //!!?? m_selection.reset();
+	invalidate();
 }
 
 void TextBox::delete_selected()
@@ -414,6 +415,9 @@ cerr << endl;
 
 	// Reset the cursor blink period...
 	m_cursorTimer.restart();
+	if (focused()) schedule_blink();
+
+	invalidate();
 }
 
 
@@ -596,6 +600,9 @@ void TextBox::onMouseMoved(float x, float)
 
 void TextBox::onMouseWheelMoved(int delta)
 {
+	// Only while focused, so it doesn't hijack the scrolling of the page
+	if (!focused()) return decline_wheel();
+
 	auto ctrl = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl) ||
 	            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RControl);
 
@@ -631,6 +638,9 @@ void TextBox::onActivationChanged(ActivationState state)
 	{
 		clear_selection();
 	}
+
+	// Start (or stop) blinking
+	schedule_blink();
 }
 
 
@@ -673,41 +683,80 @@ void TextBox::onThemeChanged()
 
 
 //----------------------------------------------------------------------------
+void TextBox::onTick()
+{
+	if (!focused())
+		return;
+
+	// Make the cursor blink
+	// (This used to be done in draw(), but then the GUI couldn't tell if a
+	// redraw is actually needed, so now we only invalidate on visible change.)
+	float timer = m_cursorTimer.getElapsedTime().asSeconds();
+	if (timer >= m_cursorBlinkPeriod) {
+		m_cursorTimer.restart();
+		timer = 0;
+	}
+
+	uint8_t alpha = (m_cursorStyle == PULSE ? uint8_t(255 - (255 * timer / m_cursorBlinkPeriod))
+	                                        : uint8_t(255 - (255 * timer / m_cursorBlinkPeriod)) & 128 ? 255 : 0);
+	if (alpha != m_cursorColor.a)
+	{
+		m_cursorColor.a = alpha;
+		m_cursorRect.setFillColor(m_cursorColor);
+		invalidate();
+	}
+
+	schedule_blink();
+}
+
+
+void TextBox::schedule_blink()
+{
+	auto* gui = getMain();
+	if (!gui) return;
+
+	gui->stopTimer(m_blinkTimer);
+	m_blinkTimer = {};
+	if (!focused()) return;
+
+	// This is called via a one-shot timer (instead of ticking every frame):
+	// BLINK only changes at the middle and the end of the period, so it can
+	// sleep until then; PULSE fades continuously, so just at a modest rate.
+	constexpr float PULSE_STEP = 1.f / 30; // s
+	float timer = m_cursorTimer.getElapsedTime().asSeconds();
+	float half = m_cursorBlinkPeriod / 2;
+	float delay = m_cursorStyle == PULSE ? PULSE_STEP
+	            : (timer < half ? half : m_cursorBlinkPeriod) - timer;
+
+	m_blinkTimer = gui->startTimer(delay, [this] { onTick(); }, 0, this);
+}
+
+
 void TextBox::draw(const gfx::RenderContext& ctx) const
 {
 	auto sfml_renderstates = ctx.props;
 	sfml_renderstates.transform *= getTransform();
-	ctx.target.draw(m_box, sfml_renderstates);
-
-	// Crop the text with GL Scissor
-	glEnable(GL_SCISSOR_TEST);
+	ctx.draw(m_box, sfml_renderstates);
 
-	sf::Vector2f pos = getAbsolutePosition();
-	auto width = max(0.f, getSize().x - 2 * Theme::borderSize - 2 * Theme::PADDING); // glScissor will fail if < 0!
-
-	glScissor(
-		(GLint)(pos.x + Theme::borderSize + Theme::PADDING),
-		(GLint)(ctx.target.getSize().y - (pos.y + getSize().y)),
-		(GLsizei)width,
-		(GLsizei)getSize().y
-	);
+	// Crop the text to the inside of the box
+	auto width = max(0.f, getSize().x - 2 * Theme::borderSize - 2 * Theme::PADDING);
+	gfx::RenderContext lctx{ctx.target, sfml_renderstates, ctx.renderer, ctx.clip};
+	auto textctx = lctx.clipped({{Theme::borderSize + Theme::PADDING, 0}, {width, getSize().y}});
 	//!!Original: (tends to overflow the input rect -- how come it worked upstream?! :-o )
 	//!!glScissor(pos.x + Theme::borderSize, ctx.target.getSize().y - (pos.y + getSize().y), getSize().x, getSize().y);
 
 	if (m_text.getString().isEmpty())
 	{
-		ctx.target.draw(m_placeholder, sfml_renderstates);
+		textctx.draw(m_placeholder, sfml_renderstates);
 	}
 	else
 	{
 		// Draw the selection highlight as a background rect.
 		if (m_selection)
-			ctx.target.draw(m_selectionMarker, sfml_renderstates);
+			textctx.draw(m_selectionMarker, sfml_renderstates);
 		// Draw the text
-		ctx.target.draw(m_text, sfml_renderstates);
+		textctx.draw(m_text, sfml_renderstates);
 	}
-
-	glDisable(GL_SCISSOR_TEST);
 /*
 	sf::RectangleShape clip;
 	clip.setPosition({Theme::borderSize + Theme::PADDING, 0});
@@ -720,20 +769,8 @@ void TextBox::draw(const gfx::RenderContext& ctx) const
 	// Show cursor if focused
 	if (focused())
 	{
-		// Make it blink
-		// Hijacking draw() as a timer tick callback... :) Hi five to Alexandre@upstream for the brilliant idea!
-		float timer = m_cursorTimer.getElapsedTime().asSeconds();
-		if (timer >= m_cursorBlinkPeriod) {
-			m_cursorTimer.restart();
-		}
-
-		m_cursorColor.a = (m_cursorStyle == PULSE ? uint8_t(255 - (255 * timer / m_cursorBlinkPeriod))
-		                                          : uint8_t(255 - (255 * timer / m_cursorBlinkPeriod)) & 128 ? 255 : 0);
-		m_cursorRect.setFillColor(m_cursorColor);
-		ctx.target.draw(m_cursorRect, sfml_renderstates);
+		ctx.draw(m_cursorRect, sfml_renderstates); // (Blinking is done in onTick())
 	}
-
-	//!!??Not needed now, but could be here: glDisable(GL_SCISSOR_TEST);
 }
 
 
@@ -758,6 +795,7 @@ sf::String TextBox::getSelectedString() const
 TextBox*  TextBox::setPlaceholderString(const sf::String& placeholder)
 {
 	m_placeholder.setString(placeholder);
+	invalidate();
 	return this;
 }
 
@@ -3,6 +3,9 @@
 
 #include <SFML/Window/Mouse.hpp>
 
+#include <algorithm> // min, clamp
+#include <cstdint>
+
 #include "sfw/util/diagnostics.hpp"
 
 namespace sfw {
@@ -23,6 +26,12 @@ Tooltip::Tooltip(Widget* owner, std::string text):
 //----------------------------------------------------------------------------
 Tooltip::Tooltip(Widget* owner) : Tooltip(owner, "") {}
 
+//----------------------------------------------------------------------------
+Tooltip::~Tooltip()
+{
+	if (m_gui) std::erase(m_gui->m_activeTooltips, this);
+}
+
 
 //----------------------------------------------------------------------------
 bool Tooltip::armed() const { return m_state != Off; }
@@ -34,7 +43,19 @@ bool Tooltip::visible() const { return m_state == Showing || m_state == Fadeout;
 void Tooltip::setState(State s)
 {
 	m_state = s;
-	if (auto gui = getMain(); gui) m_timeStateChange = gui->sessionTime();
+	if (auto gui = getMain(); gui)
+	{
+		m_timeStateChange = gui->sessionTime();
+		m_lastFadeStep = m_timeStateChange;
+		gui->invalidate(); // Not a tree node (yet), so can't just invalidate() itself
+
+		// Join the GUI's active list (it will drop us after we're turned off)
+		if (armed() && !m_gui)
+		{
+			m_gui = gui;
+			gui->m_activeTooltips.push_back(this);
+		}
+	}
 //cerr << "-> Tooltip::setState("<<s<<")\n";
 }
 
@@ -47,13 +68,27 @@ bool Tooltip::elapsed(float time_interval)
 		return false;
 }
 
+//----------------------------------------------------------------------------
+float Tooltip::nextChange() const
+{
+	switch (m_state)
+	{
+	case Delayed: return m_timeStateChange + DELAY_TIME;
+	case Showing: return m_timeStateChange + SUSTAIN_MIN + float(m_length) * READING_RATE;
+	default:      // Fading out: the next step, paced like per-tick animations
+		return std::min(m_lastFadeStep + GUI::FRAME_INTERVAL, m_timeStateChange + FADEOUT_TIME);
+	}
+}
+
 //----------------------------------------------------------------------------
 void Tooltip::setText(const std::string& text)
 {
-	m_text.set(text);
+	m_content = text;
 	m_length = text.length();
 
-	m_text.setCharacterSize(11);
+	// Otherwise it's left for initView() (i.e. arm()) to create the text:
+	if (m_text)
+		m_text->set(m_content);
 }
 
 
@@ -63,9 +98,7 @@ void Tooltip::show()
 	if (auto gui = getMain(); gui)
 	{
 		// Reset the colors changed by Fadeout
-		m_box.colorFill = sf::Color(255, 255, 220, 224);
-		m_box.colorBorder = m_box.colorFill; m_box.colorBorder *= sf::Color(160, 160, 160, 255);
-		m_text.setFillColor(sf::Color(0, 0, 0, 255));
+		set_opacity(1);
 /*!!
 		m_mouseLastPos = gui->getMousePosition();
 //DEBUG:		setPosition(m_mouseLastPos);
@@ -109,6 +142,27 @@ void Tooltip::dismiss()
 	setState(visible() ? Fadeout : Off);
 }
 
+//----------------------------------------------------------------------------
+void Tooltip::cancel()
+{
+	if (armed()) setState(Off);
+	if (m_gui)
+	{
+		std::erase(m_gui->m_activeTooltips, this);
+		m_gui = nullptr;
+	}
+}
+
+
+//----------------------------------------------------------------------------
+void Tooltip::set_opacity(float opacity)
+{
+	auto alpha = [opacity](float full) { return std::uint8_t(std::clamp(opacity, 0.f, 1.f) * full); };
+	m_box.colorFill = sf::Color(255, 255, 220, alpha(224));
+	m_box.colorBorder = m_box.colorFill; m_box.colorBorder *= sf::Color(160, 160, 160, 255);
+	if (m_text) m_text->setFillColor(sf::Color(0, 0, 0, alpha(255)));
+}
+
 
 //----------------------------------------------------------------------------
 void Tooltip::initView()
@@ -117,9 +171,13 @@ void Tooltip::initView()
 	if (!gui)  //!! Should be assert()! This fn. shouldn't be called "offline"!
 		return;
 
+	// Build the text lazily, on the first actual use
+	if (!m_text)
+		m_text.emplace(m_content, 11);
+
 	auto padding = sf::Vector2f{3, 2};
 
-	auto textrect = m_text.getLocalBounds();
+	auto textrect = m_text->getLocalBounds();
 	auto size = sf::Vector2f{textrect.width + 2*padding.x,
 	                        textrect.height + 2*padding.y + textrect.top}; // SFML text size hackery :-/
 
@@ -170,20 +228,20 @@ void Tooltip::initView()
 	}
 
 	m_box.size = size;
-	m_text.setPosition({padding.x, padding.y});
+	m_text->setPosition({padding.x, padding.y});
 }
 
 
 //----------------------------------------------------------------------------
 void Tooltip::draw(const gfx::RenderContext& ctx) const
 {
-	if (visible())
+	if (visible() && m_text)
 	{
 		auto sfml_renderstates = ctx.props;
 		sfml_renderstates.transform *= getTransform();
 		
-		ctx.target.draw(m_box, sfml_renderstates);
-		ctx.target.draw(m_text, sfml_renderstates);
+		ctx.draw(m_box, sfml_renderstates);
+		ctx.draw(*m_text, sfml_renderstates);
 	}
 }
 
@@ -206,16 +264,14 @@ void Tooltip::onTick()
 			setState(Fadeout);
 		break;
 	case Fadeout:
-		{uint8_t DELTA = 8;
-			if (m_box.colorFill.a > DELTA) {
-				m_box.colorFill.a -= DELTA;
-				if (m_box.colorBorder.a) m_box.colorBorder.a -= DELTA;
-				m_text.setFillColor(sf::Color(0, 0, 0, m_text.getFillColor().a - DELTA));
-			}
-			else setState(Off);
-			/*if (elapsed(FADEOUT_TIME))
-				setState(Off);	
-			*/
+		// Time-based (not per-tick), so it takes the same time at any frame rate
+		if (elapsed(FADEOUT_TIME))
+			setState(Off);
+		else
+		{
+			m_lastFadeStep = gui->sessionTime();
+			set_opacity(1 - (m_lastFadeStep - m_timeStateChange) / FADEOUT_TIME);
+			gui->invalidate();
 		}
 		break;
 	default:;
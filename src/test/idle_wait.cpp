@@ -0,0 +1,72 @@
+#include "sfw/GUI.hpp"
+#include "sfw/Widgets/Tooltip.hpp"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <iostream>
+using namespace std;
+
+// An idle waitAndProcess() loop should sleep between the timer deadlines
+// (not spin), but still keep the timers firing. Fading out a tooltip should
+// not make it spin either (nor cut the fading short).
+int main()
+{
+	sf::RenderWindow window(sf::VideoMode({64, 64}), "SFW idle wait test", sf::Style::Titlebar);
+
+	using namespace sfw;
+	GUI gui(window);
+	if (!gui) {
+		cerr << "- Warning: Couldn't set up a GUI (no display?), skipping the test.\n";
+		return 0;
+	}
+
+	int fired = 0;
+	gui.startTimer(0.05f, [&] { ++fired; }, 0.05f);
+
+	int loops = 0;
+	for (sf::Clock clock; clock.getElapsedTime().asSeconds() < 0.5f; ++loops)
+	{
+		if (!gui.waitAndProcess(window)) break;
+		if (gui.needsRedraw()) { gui.render(); window.display(); }
+	}
+
+	cerr << "Timer fired " << fired << " times, in " << loops << " loop iterations.\n";
+
+	if (fired < 5) {
+		cerr << "- ERROR: The timer has stalled!\n";
+		return 1;
+	}
+	if (loops > 100) { // ~10 + a few window events would be normal; a busy loop is thousands
+		cerr << "- ERROR: The loop doesn't sleep!\n";
+		return 1;
+	}
+
+	// Fade out a tooltip
+	auto* owner = gui.add(new Label("Tooltip owner"));
+	Tooltip tooltip(owner, "Fading...");
+	tooltip.arm();
+	tooltip.show();
+	tooltip.dismiss();
+
+	loops = 0;
+	sf::Clock fade_clock;
+	for (; tooltip.armed() && fade_clock.getElapsedTime().asSeconds() < 5; ++loops)
+	{
+		if (!gui.waitAndProcess(window)) break;
+		if (gui.needsRedraw()) { gui.render(); window.display(); }
+	}
+	auto fade_time = fade_clock.getElapsedTime().asSeconds();
+
+	cerr << "Tooltip faded out in " << fade_time << " s, in " << loops << " loop iterations.\n";
+
+	if (fade_time < 1.5f) { // Tooltip::FADEOUT_TIME is 2 s
+		cerr << "- ERROR: The tooltip faded out too fast!\n";
+		return 1;
+	}
+	if (loops > 300) { // ~60/s (+ the timer) would be normal
+		cerr << "- ERROR: The loop doesn't sleep while fading!\n";
+		return 1;
+	}
+	return 0;
+}
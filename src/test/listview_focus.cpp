@@ -0,0 +1,67 @@
+#include "sfw/GUI.hpp"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+
+#include <iostream>
+#include <string>
+using namespace std;
+
+// The focus of a ListView should stay with the focused item while scrolling,
+// not with its (recycled) row widget.
+
+using namespace sfw;
+
+struct TestList : ListView
+{
+	using ListView::ListView;
+	using ListView::focus;
+	using ListView::focusedChild;
+	using ListView::setActivationState;
+
+	Widget* rowOf(size_t item)
+	{
+		for (Widget* row : *this) if (itemAt(row) == item) return row;
+		return nullptr;
+	}
+};
+
+int main()
+{
+	sf::RenderWindow window(sf::VideoMode({200, 300}), "SFW ListView focus test", sf::Style::Titlebar);
+
+	GUI gui(window);
+	if (!gui) {
+		cerr << "- Warning: Couldn't set up a GUI (no display?), skipping the test.\n";
+		return 0;
+	}
+
+	auto* list = gui.add(TestList(100, 5,
+		[] { return size_t(100); },
+		[] { return new TextBox(100); },
+		[](Widget* row, size_t item) { ((TextBox*)row)->set(to_string(item)); }));
+	gui.needsRedraw(); // Run the layout pass, creating the rows
+
+	auto fail = [](const char* what) { cerr << "- ERROR: " << what << "\n"; return 1; };
+
+	if (!list->focus(list->rowOf(2))) return fail("Couldn't focus a row!");
+
+	list->scroll(1); // Still in view
+	if (!list->focusedChild() || list->itemAt(list->focusedChild()) != 2)
+		return fail("The focus didn't follow the item while in view!");
+
+	list->scroll(10); // Out of view: its row gets recycled
+	if (list->focusedChild())
+		return fail("A recycled row has kept the focus!");
+
+	list->scroll(-11); // Back in view
+	if (!list->focusedChild() || list->itemAt(list->focusedChild()) != 2)
+		return fail("The focus hasn't been restored to the item!");
+
+	list->scrollTo(100); // Out of view, to the end
+	list->setActivationState(ActivationState::Default); // The list loses the focus meanwhile...
+	list->scrollTo(0);   // ...so it must not come back
+	if (list->focusedChild())
+		return fail("The focus has come back after being dropped!");
+
+	return 0;
+}
@@ -5,6 +5,7 @@
 #include <string> // to_string
 #include <iostream> // cerr, for errors, cout for some "demo" info
 #include <thread>
+#include <atomic>
 #include <chrono>
 #include <cassert>
 using namespace std;
@@ -12,9 +13,11 @@ using namespace std;
 // Try/check without most of the sfw:: prefixes:
 using namespace sfw;
 
-void background_thread_main(GUI& gui);
+void background_thread_main(GUI& gui, WidgetHandle<Slider> rot_slider);
 
-static auto toy_anim_on = false;
+static std::atomic<bool> toy_anim_on = false; // Also read by the bg. thread
+static std::atomic<bool> bg_thread_quit = false;
+static auto bg_progress = std::make_shared<ValueChannel<float>>(); // Written by the bg. thread
 
 int main()
 {
@@ -96,7 +99,7 @@ int main()
 
 	// #168: Form supporting any left-hand-side widget as "label"
 	auto labelbox = new VBox;
-		labelbox->add(Label("Issue #168"));
+		labelbox->emplace<Label>("Issue #168");
 		labelbox->add(circlevista);
 	test_hbox->add(new Form)->add(labelbox, new Label("OK!"));
 
@@ -137,7 +140,7 @@ int main()
 
 	// #347...
 	auto issue_347 = test_hbox->add(new Form);
-	issue_347->add("guarded box", TextBox(50));
+	issue_347->emplace<TextBox>("guarded box", 50);
 	
 
 	demo.add(new Label("––––––––––––––––––––––––––––––––––––––––––––––––––––––––––––––"
@@ -381,19 +384,27 @@ int main()
 			->setCallback([]/*(auto* w)*/ { toy_anim_on = false; });
 	}
 
+	// A long (virtualized) list
+	middle_panel->emplace<Label>("List view (10000 items):");
+	middle_panel->add(ListView(150, 5,
+		[] { return size_t(10000); },
+		[] { return new Label; },
+		[](Widget* row, size_t item) { ((Label*)row)->setText("Item #" + to_string(item)); }),
+		"listview");
+
 
 	//--------------------------------------------------------------------
 	// Image views...
 
 	// Image directly from file
 	auto vboximg = main_hbox->add(VBox());
-	vboximg->add(Label("Image from file:"));
+	vboximg->emplace<Label>("Image from file:");
 	vboximg->add(Image("demo/some image.png"));
 
 	// Image crop from file
-	vboximg->add(Label("Crop from file:"));
+	vboximg->emplace<Label>("Crop from file:");
 	vboximg->add(Image("demo/some image.png", {{0, 33}, {24, 28}}));
-	vboximg->add(Label("Image crop varied:"));
+	vboximg->emplace<Label>("Image crop varied:");
 
 	// Image from file, cropped dynamically
 	Image* imgCrop = new Image("demo/martinet-dragonfly.jpg");
@@ -410,11 +421,22 @@ int main()
 	});
 
 	auto boxcrop = vboximg->add(new HBox);
-		boxcrop->add(Label("Crop square size:"));
+		boxcrop->emplace<Label>("Crop square size:");
 		boxcrop->add(ProgressBar(40), "cropbar");
 
 	vboximg->add(imgCrop);
-	vboximg->add(Label("(Art: © Édouard Martinet)"))->setStyle(sf::Text::Style::Italic);
+	vboximg->emplace<Label>("(Art: © Édouard Martinet)")->setStyle(sf::Text::Style::Italic);
+
+	// Scrolling content (use the m. wheel)
+	vboximg->emplace<Label>("Scroll area:");
+	auto scroller = vboximg->add(ScrollArea({0, 80}));
+	scroller->setCacheAsBitmap(); // Only repaint the uncovered strips when scrolling
+	for (int i = 1; i <= 12; ++i)
+	{
+		auto row = scroller->add(new HBox);
+		row->emplace<CheckBox>();
+		row->emplace<Label>("Scrolled line " + to_string(i));
+	}
 
 
 	//--------------------------------------------------------------------
@@ -423,7 +445,7 @@ int main()
 
 	// Theme selection
 	using OBTheme = OptionsBox<Theme::Cfg>;
-	right_bar->add(Label("Change theme:"));
+	right_bar->emplace<Label>("Change theme:");
 	auto themeselect = new OBTheme([&](auto* w) {
 		const auto& themecfg = w->current();
 		demo.setTheme(themecfg); // Swallowing the error for YOLO reasons ;)
@@ -437,7 +459,7 @@ int main()
 	// Theme font size slider
 	// (Also directly changes the font size of the theme cfg. data stored in the
 	// "theme-selector" widget, so that it remembers the updated size (for each theme)!)
-	right_bar->add(Label("Theme font size (use the m. wheel):"));
+	right_bar->emplace<Label>("Theme font size (use the m. wheel):");
 	right_bar->add(Slider({.length = 100, .range = {8, 18}}))
 		->set((float)themes[DEFAULT_THEME].textSize)
 		->setCallback([&] (auto* w){
@@ -449,7 +471,7 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 		});
 
 	// Show the current theme texture bitmaps
-	right_bar->add(Label("Theme textures:"));
+	right_bar->emplace<Label>("Theme textures:");
 	auto txbox = right_bar->add(new HBox);
 	struct ThemeBitmap : public Image {
 		ThemeBitmap() : Image(Theme::getTexture()) {}
@@ -462,7 +484,7 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 		->update(4.f); // use update(), not set(), to trigger the callback!
 	txbox->add(themeBitmap);
 
-	right_bar->add(Label(" ")); // Just for some space, indeed...
+	right_bar->emplace<Label>(" "); // Just for some space, indeed...
 
 	// Playing with the background...
 	auto bgform = right_bar->add(new Form);
@@ -493,14 +515,14 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 
 	// A pretty useless, but interesting clear-background checkbox
 	auto hbox4 = right_bar->add(new HBox);
-	hbox4->add(Label("Clear background"));
+	hbox4->emplace<Label>("Clear background");
 	// + a uselessly convoluted name-lookup through its own widget pointer, to confirm
 	// the get() name fix of #200 (assuming CheckBox still has its "real" get()):
 	hbox4->add(CheckBox([&](auto* w) { Theme::clearBackground = getWidget<CheckBox>("findme", w)->get(); },
 	                    true), "findme");
 
 	auto disable_all_box = right_bar->add(new HBox);
-	disable_all_box->add(Label("Disable/Enable all"));
+	disable_all_box->emplace<Label>("Disable/Enable all");
 	disable_all_box->add(CheckBox([&](auto* chkbox) {
 		demo.traverse([&](auto* widget) {
 			if (widget != chkbox) widget->enable(chkbox->get()); // Leave the checkbox alive! :)
@@ -607,9 +629,26 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 	std::ignore = SFW_QUERY_WIDGET(TextBox, "MACRO_TEST... (VARIADIC)", get); //!! No default, so should be error-checked!
 	SFW_UPDATE_WIDGET(TextBox, "MACRO_TEST... (VARIADIC)", set, "crap");
 
+	//--------------------------------------------------------------------
+	// Widget removal, and generational handles...
+	//
+	WidgetHandle<Label> temp_label = demo.emplaceNamed<Label>("temp label", "(temporary)");
+	cerr << "Handle of a live widget (should be 1): " << (bool)temp_label << '\n';
+	demo.remove(temp_label.get());
+	cerr << "Handle of the removed widget (should be 0): " << (bool)temp_label << '\n';
+	cerr << "Name of the removed widget (should be gone, with a warning): " << demo.recall("temp label") << '\n';
+
+	//--------------------------------------------------------------------
+	// Output widgets fed by another thread, via a value channel...
+	//
+	auto bg_box = demo.add(new HBox);
+	bg_box->add(ProgressBar(100))->bind(bg_progress);
+	bg_box->emplace<Label>()->bind(bg_progress, [](float v) { return "bg. thread: " + to_string(int(v)); });
+
 	//--------------------------------------------------------------------
 	// Start another thread for some unrelated job
-	thread bg_thread(background_thread_main, std::ref(demo));
+	// (The handle must be taken here, on the GUI thread.)
+	thread bg_thread(background_thread_main, std::ref(demo), WidgetHandle<Slider>(getWidget<Slider>("Rotation", demo)));
 
 	//--------------------------------------------------------------------
 	// The event loop
@@ -646,35 +685,34 @@ cerr << "font size: "<< themecfg.textSize << endl; //!!#196
 	}
 
 	//--------------------------------------------------------------------
-	// Finish the bg. thread, too
+	// Finish the bg. thread, too (before the GUI is gone!)
+	bg_thread_quit = true;
 	bg_thread.join();
 
 	return EXIT_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
-void background_thread_main(GUI& gui)
+void background_thread_main(GUI& gui, WidgetHandle<Slider> rot_slider)
 {
-	auto rot_slider = getWidget<Slider>("Rotation", gui);
-	if (!rot_slider)
-		return;
-
-	for (size_t n = 0; gui;)
+	// The GUI (and the widgets) must only be used by the GUI thread, so
+	// this thread just posts the changes for it to run (see GUI::post())
+	for (size_t n = 0; !bg_thread_quit;)
 	{
 		// Cycle the rot. slider
-	        auto sampletext_angle = sf::degrees(rot_slider->get() * 3 + 4);
-		rot_slider->update(float(int(sampletext_angle.asDegrees()/3) % 100));
+		gui.post(rot_slider, [](Slider* slider) {
+			auto sampletext_angle = sf::degrees(slider->get() * 3 + 4);
+			slider->update(float(int(sampletext_angle.asDegrees()/3) % 100));
+		});
 
 		// Keep on sleeping while the anim. is disabled.
-		// But still also poll the GUI for termination.
-		// NOTE: it's important to do this AFTER manipulating the widget
-		// exactly because the GUI may have been shut down in the meantime,
-		// and it's unhealthy (UB) to still use it.
+		// But still also check for termination.
 		do this_thread::sleep_for(chrono::milliseconds(50));
-		while (!toy_anim_on && gui);
+		while (!toy_anim_on && !bg_thread_quit);
 
 		++n;
+		bg_progress->store(float(n % 101));
 		if (n%20) continue;
-		gui.setPosition(float(10 + (n/20)%10), float(10 + (n/20)%10));
+		gui.post([&gui, n] { gui.setPosition(float(10 + (n/20)%10), float(10 + (n/20)%10)); });
 	}
 }